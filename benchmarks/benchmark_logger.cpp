@@ -0,0 +1,106 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "eurora/utils/logger.h"
+
+namespace chrono = std::chrono;
+namespace fs     = std::filesystem;
+using namespace eurora::utils;
+
+namespace {
+
+constexpr int kBatch   = 1000;  // Statements per timed batch; small enough to fit one thread's ring.
+constexpr int kBatches = 200;
+
+std::string WriteConfig(const fs::path& directory) {
+    fs::create_directories(directory);
+    auto config = directory / "benchmark_log_config.json";
+    std::ofstream file(config);
+    file << R"({
+        "log_level": "info",
+        "log_flush_level": "fatal",
+        "enable_console_log": false,
+        "enable_file_log": true,
+        "log_file_path": ")"
+         << (directory / "benchmark.log").generic_string() << R"(",
+        "max_file_size": 104857600,
+        "max_files": 2
+    })";
+    return config.string();
+}
+
+/// Average cost of one call of `statement`, timing batches and running `between` outside the timed region.
+template <typename Statement, typename Between>
+double NanosPerCall(Statement&& statement, Between&& between) {
+    chrono::nanoseconds total{0};
+    for (int batch = 0; batch < kBatches; ++batch) {
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < kBatch; ++i) {
+            statement(i);
+        }
+        total += chrono::steady_clock::now() - start;
+        between();
+    }
+    return static_cast<double>(total.count()) / (kBatch * kBatches);
+}
+
+double AsyncNanosPerCallFromThreads(int threads) {
+    std::vector<double> results(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&results, t]() {
+            results[t] = NanosPerCall([t](int i) { LOG_INFO("worker {} processed slice {} in {:.3f} ms", t, i, i * 0.01); },
+                                      []() { Logger::Instance().Flush(); });
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double sum = 0;
+    for (double result : results) {
+        sum += result;
+    }
+    return sum / threads;
+}
+
+}  // namespace
+
+int main() {
+    auto directory = fs::temp_directory_path() / "eurora_benchmark_logger";
+    auto& logger   = Logger::Instance();
+    if (!logger.InitFromConfig(WriteConfig(directory))) {
+        std::cerr << "Failed to initialize the logger" << std::endl;
+        return 1;
+    }
+
+    const std::string name = "kspace";
+    auto nothing           = []() {};
+    auto flush             = [&logger]() { logger.Flush(); };
+
+    auto disabled_format = NanosPerCall([&name](int i) { LOG_DEBUG("slice {} of {} at {:.3f}", i, name, i * 0.01); }, nothing);
+    auto disabled_stream = NanosPerCall([&name](int i) { STREAM_DEBUG() << "slice " << i << " of " << name; }, nothing);
+    auto sync_format     = NanosPerCall([&name](int i) { LOG_INFO("slice {} of {} at {:.3f}", i, name, i * 0.01); }, nothing);
+    auto sync_stream     = NanosPerCall([&name](int i) { STREAM_INFO() << "slice " << i << " of " << name; }, nothing);
+
+    logger.EnableAsync();
+    auto async_format = NanosPerCall([&name](int i) { LOG_INFO("slice {} of {} at {:.3f}", i, name, i * 0.01); }, flush);
+    auto async_four   = AsyncNanosPerCallFromThreads(4);
+    logger.Flush();
+    auto dropped = logger.DroppedRecords();
+    logger.Shutdown();
+
+    std::cout << "Disabled LOG_DEBUG (ns/call): " << disabled_format << std::endl;
+    std::cout << "Disabled STREAM_DEBUG (ns/call): " << disabled_stream << std::endl;
+    std::cout << "Enabled LOG_INFO, synchronous (ns/call): " << sync_format << std::endl;
+    std::cout << "Enabled STREAM_INFO, synchronous (ns/call): " << sync_stream << std::endl;
+    std::cout << "Enabled LOG_INFO, asynchronous (ns/call): " << async_format << std::endl;
+    std::cout << "Enabled LOG_INFO, asynchronous, 4 threads (ns/call): " << async_four << ", dropped: " << dropped << std::endl;
+
+    fs::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/messaging/mpmc_channel.h"
+#include "core/thread_safe_queue.hpp"
+
+namespace chrono = std::chrono;
+using namespace eurora::core;
+
+namespace {
+
+constexpr int kItems     = 2'000'000;
+constexpr int kBatchSize = 256;  // Readout lines the ingest thread hands over at once.
+
+/// Nanoseconds per item moved from one producer to one consumer, one item or one batch per call.
+template <typename Push, typename Pop>
+double NanosPerItem(Push&& push, Pop&& pop) {
+    auto start = chrono::steady_clock::now();
+    std::thread producer([&push]() {
+        std::vector<int> batch(kBatchSize);
+        for (int i = 0; i < kItems; i += kBatchSize) {
+            push(batch);
+        }
+    });
+    for (int received = 0; received < kItems;) {
+        received += pop();
+    }
+    producer.join();
+    return static_cast<double>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count()) / kItems;
+}
+
+void Report(const std::string& name, double single, double bulk) {
+    std::cout << name << ": per item (ns): " << single << ", bulk (ns): " << bulk << ", speedup: " << single / bulk << "x" << std::endl;
+}
+
+}  // namespace
+
+int main() {
+    {
+        ThreadSafeQueue<int> queue;
+        std::vector<int> out;
+        out.reserve(kBatchSize);
+        auto single = NanosPerItem(
+            [&queue](std::vector<int>& batch) {
+                for (int value : batch) {
+                    queue.Push(value);
+                }
+            },
+            [&queue]() {
+                queue.Pop();
+                return 1;
+            });
+        auto bulk = NanosPerItem([&queue](std::vector<int>& batch) { queue.PushBulk(batch); },
+                                 [&queue, &out]() {
+                                     out.clear();
+                                     return static_cast<int>(queue.PopBulk(std::back_inserter(out), kBatchSize));
+                                 });
+        Report("ThreadSafeQueue", single, bulk);
+    }
+
+    {
+        MPMCChannel<int> channel;
+        std::vector<int> out;
+        out.reserve(kBatchSize);
+        auto single = NanosPerItem(
+            [&channel](std::vector<int>& batch) {
+                for (int value : batch) {
+                    channel.push(value);
+                }
+            },
+            [&channel]() {
+                channel.pop();
+                return 1;
+            });
+        auto bulk = NanosPerItem([&channel](std::vector<int>& batch) { channel.push_bulk(batch); },
+                                 [&channel, &out]() {
+                                     out.clear();
+                                     return static_cast<int>(channel.pop_bulk(std::back_inserter(out), kBatchSize));
+                                 });
+        Report("MPMCChannel", single, bulk);
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "task_manager.h"
+
+namespace chrono = std::chrono;
+using namespace eurora::fe;
+
+struct Result {
+    std::size_t updates = 0;
+    std::size_t pages   = 0;
+    double p50_us       = 0;
+    double p99_us       = 0;
+    double max_us       = 0;
+};
+
+Result RunMixedLoad(std::size_t num_tasks, int updaters, int listers, chrono::milliseconds duration) {
+    TaskManager manager;
+
+    const std::vector<std::string> inputs = {"/data/scan/meas_0001.h5", "/data/scan/meas_0002.h5", "/data/scan/noise.h5"};
+    std::vector<std::string> ids;
+    ids.reserve(num_tasks);
+    for (std::size_t i = 0; i < num_tasks; ++i) {
+        ids.push_back(manager.createTask(inputs, "/data/out/" + std::to_string(i) + ".h5"));
+        if (i % 3 == 0) {
+            manager.updateTaskStatus(ids.back(), TaskManager::kCompleted);
+        }
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<std::size_t> pages{0};
+    std::vector<std::vector<double>> latencies(updaters);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < updaters; ++t) {
+        threads.emplace_back([&, t]() {
+            std::mt19937 gen(t);
+            std::uniform_int_distribution<std::size_t> pick(0, ids.size() - 1);
+            while (!stop.load(std::memory_order_relaxed)) {
+                const auto& id = ids[pick(gen)];
+                auto start     = chrono::steady_clock::now();
+                if (gen() % 8 == 0) {
+                    manager.updateTaskStatus(id, gen() % 2 ? TaskManager::kRunning : TaskManager::kQueued);
+                } else {
+                    manager.updateTaskProgress(id, static_cast<double>(gen() % 100) / 100.0);
+                }
+                latencies[t].push_back(chrono::duration<double, std::micro>(chrono::steady_clock::now() - start).count());
+            }
+        });
+    }
+
+    // Dashboards: walk every page, alternating between the full list and a status filtered view.
+    for (int t = 0; t < listers; ++t) {
+        threads.emplace_back([&, t]() {
+            bool filtered = t % 2 == 1;
+            while (!stop.load(std::memory_order_relaxed)) {
+                TaskManager::ListQuery query;
+                query.limit = 100;
+                if (filtered) {
+                    query.status = TaskManager::kRunning;
+                }
+                do {
+                    auto page   = manager.listTasks(query);
+                    query.after = page.next_cursor;
+                    pages.fetch_add(1, std::memory_order_relaxed);
+                } while (query.after != 0 && !stop.load(std::memory_order_relaxed));
+                filtered = !filtered;
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(duration);
+    stop = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<double> all;
+    for (auto& samples : latencies) {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    std::sort(all.begin(), all.end());
+
+    Result result;
+    result.updates = all.size();
+    result.pages   = pages.load();
+    if (!all.empty()) {
+        result.p50_us = all[all.size() / 2];
+        result.p99_us = all[all.size() * 99 / 100];
+        result.max_us = all.back();
+    }
+    return result;
+}
+
+int main() {
+    const std::vector<std::size_t> task_counts = {10000, 50000};
+    const auto duration                        = chrono::seconds(2);
+
+    for (std::size_t tasks : task_counts) {
+        for (int listers : {0, 2, 4}) {
+            auto result = RunMixedLoad(tasks, 4, listers, duration);
+            std::cout << "Tasks: " << tasks << ", Updaters: 4, Listers: " << listers << ", Updates/s: " << result.updates / 2
+                      << ", Pages/s: " << result.pages / 2 << ", Update p50 (us): " << result.p50_us << ", p99 (us): " << result.p99_us
+                      << ", max (us): " << result.max_us << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "eurora/utils/trace.h"
+
+namespace chrono = std::chrono;
+using namespace eurora::utils;
+
+namespace {
+
+constexpr int kSpans = 1'000'000;
+
+/// Average cost of one empty span on each of `threads` threads.
+double NanosPerSpan(int threads) {
+    std::vector<double> results(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&results, t]() {
+            auto start = chrono::steady_clock::now();
+            for (int i = 0; i < kSpans; ++i) {
+                EURORA_TRACE_SCOPE("benchmark", "span");
+            }
+            results[t] = static_cast<double>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count()) / kSpans;
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double sum = 0;
+    for (double result : results) {
+        sum += result;
+    }
+    return sum / threads;
+}
+
+/// A recording span reads the clock twice, so this bounds how cheap it can be on a given machine.
+double NanosPerClockRead() {
+    std::int64_t sum = 0;
+    auto start       = chrono::steady_clock::now();
+    for (int i = 0; i < kSpans; ++i) {
+        sum += Tracer::Now();
+    }
+    auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    return sum == 0 ? 0 : static_cast<double>(elapsed) / kSpans;
+}
+
+}  // namespace
+
+int main() {
+    auto& tracer = Tracer::Instance();
+    std::cout << "Clock read (ns): " << NanosPerClockRead() << std::endl;
+
+    for (int threads : {1, 4}) {
+        tracer.Stop();
+        auto disabled = NanosPerSpan(threads);
+
+        tracer.Start(kSpans);
+        auto enabled = NanosPerSpan(threads);
+        tracer.Stop();
+
+        std::cout << "Threads: " << threads << ", disabled span (ns): " << disabled << ", recording span (ns): " << enabled
+                  << ", events: " << tracer.EventCount() << ", dropped: " << tracer.DroppedEvents() << std::endl;
+    }
+
+    return 0;
+}
@@ -97,6 +97,10 @@ if(${PROJECT_NAME}_ENABLE_ASAN)
     add_link_options(-fsanitize=address)
 endif()
 
+set(${PROJECT_NAME}_LOG_ACTIVE_LEVEL "TRACE" CACHE STRING "Lowest log level compiled in: TRACE, DEBUG, INFO, WARN, ERROR, FATAL or OFF.")
+set_property(CACHE ${PROJECT_NAME}_LOG_ACTIVE_LEVEL PROPERTY STRINGS TRACE DEBUG INFO WARN ERROR FATAL OFF)
+add_compile_definitions(EURORA_LOG_ACTIVE_LEVEL=EURORA_LOG_LEVEL_${${PROJECT_NAME}_LOG_ACTIVE_LEVEL})
+
 # Specify the output directory for executables
 set(CMAKE_RUNTIME_OUTPUT_DIRECTORY ${CMAKE_BINARY_DIR}/bin)
 
@@ -41,7 +41,9 @@ class EuroraConan(ConanFile):
         "hdf5/1.14.1",
         "pugixml/1.13",
         "fftw/3.3.10",
-        "onetbb/2021.12.0"
+        "onetbb/2021.12.0",
+        "lz4/1.9.4",
+        "zstd/1.5.5"
     ]
 
     tool_requires = [
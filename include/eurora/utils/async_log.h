@@ -0,0 +1,218 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "eurora/utils/logger_level.h"
+
+namespace eurora::utils {
+
+/// The file name part of a path; consteval so `__FILE__` never costs anything at runtime.
+consteval const char* FileBasename(const char* path) {
+    const char* name = path;
+    for (const char* p = path; *p != '\0'; ++p) {
+        if (*p == '/' || *p == '\\') {
+            name = p + 1;
+        }
+    }
+    return name;
+}
+
+/**
+ * Single-producer, single-consumer ring of variable sized records.
+ *
+ * Each record is prefixed with its size and padded to 8 bytes. A record that does not fit before the end of the
+ * buffer is preceded by a skip marker, so records are always contiguous and can be read in place.
+ */
+class LogRing {
+public:
+    explicit LogRing(std::size_t capacity) : capacity_(RoundUp(capacity)), buffer_(std::make_unique<std::byte[]>(capacity_)) {}
+
+    LogRing(const LogRing&)            = delete;
+    LogRing& operator=(const LogRing&) = delete;
+
+    std::size_t capacity() const { return capacity_; }
+
+    /// Producer side. Calls `fill` with `size` writable bytes; returns false without calling it if the ring is full.
+    template <typename Fill>
+    bool TryWrite(std::size_t size, Fill&& fill);
+
+    /// Consumer side. Calls `consume(data, size)` for every committed record and returns how many there were.
+    template <typename Consume>
+    std::size_t Drain(Consume&& consume);
+
+    bool Empty() const { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
+
+private:
+    struct Prefix {
+        std::uint32_t size;  // Including the prefix and padding.
+        std::uint32_t skip;  // Non-zero for the filler in front of a wrapped record.
+    };
+
+    static constexpr std::size_t Align(std::size_t size) { return (size + 7) & ~std::size_t{7}; }
+
+    static std::size_t RoundUp(std::size_t capacity) {
+        std::size_t rounded = 4096;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+private:
+    const std::size_t capacity_;
+    std::unique_ptr<std::byte[]> buffer_;
+
+    alignas(64) std::atomic<std::uint64_t> head_{0};
+    std::uint64_t cached_tail_ = 0;  // Producer's last view of tail_, refreshed only when the ring looks full.
+
+    alignas(64) std::atomic<std::uint64_t> tail_{0};
+};
+
+/// What the front end stores per statement; the arguments follow in their binary form.
+struct LogRecord {
+    using FormatFunction = std::string (*)(std::string_view format, const std::byte* args);
+
+    FormatFunction format;
+    std::string_view format_string;
+    const char* file;
+    const char* function;
+    std::int64_t timestamp_ns;  // system_clock
+    int line;
+    LogLevel level;
+};
+
+namespace detail {
+
+/// Arguments copied as text: literals, std::string, std::string_view and C strings.
+template <typename T>
+concept LogStringArg = std::is_convertible_v<const T&, std::string_view>;
+
+/// Arguments that can be captured into a LogRecord and formatted later, on another thread.
+template <typename T>
+concept LogRecordArg = LogStringArg<T> || std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_same_v<T, const void*> || std::is_same_v<T, void*>;
+
+template <typename T>
+using LogStored = std::conditional_t<LogStringArg<T>, std::string_view, T>;
+
+template <typename T>
+std::string_view AsText(const T& value) {
+    if constexpr (std::is_pointer_v<T>) {
+        if (value == nullptr) {
+            return "(null)";
+        }
+    }
+    return std::string_view(value);
+}
+
+template <typename T>
+std::size_t EncodedSize(const T& value) {
+    if constexpr (LogStringArg<T>) {
+        return sizeof(std::uint32_t) + AsText(value).size();
+    } else {
+        return sizeof(T);
+    }
+}
+
+template <typename T>
+std::byte* Encode(std::byte* out, const T& value) {
+    if constexpr (LogStringArg<T>) {
+        auto text          = AsText(value);
+        std::uint32_t size = static_cast<std::uint32_t>(text.size());
+        std::memcpy(out, &size, sizeof(size));
+        std::memcpy(out + sizeof(size), text.data(), text.size());
+        return out + sizeof(size) + text.size();
+    } else {
+        std::memcpy(out, &value, sizeof(T));
+        return out + sizeof(T);
+    }
+}
+
+template <typename T>
+LogStored<T> Decode(const std::byte*& in) {
+    if constexpr (LogStringArg<T>) {
+        std::uint32_t size;
+        std::memcpy(&size, in, sizeof(size));
+        std::string_view text(reinterpret_cast<const char*>(in + sizeof(size)), size);
+        in += sizeof(size) + size;
+        return text;
+    } else {
+        T value;
+        std::memcpy(&value, in, sizeof(T));
+        in += sizeof(T);
+        return value;
+    }
+}
+
+template <typename... Args>
+std::string FormatRecord(std::string_view format, [[maybe_unused]] const std::byte* args) {
+    // Braced initialisation decodes the arguments left to right.
+    std::tuple<LogStored<Args>...> values{Decode<Args>(args)...};
+    return std::apply([format](const auto&... value) { return std::vformat(format, std::make_format_args(value...)); }, values);
+}
+
+}  // namespace detail
+
+/** Implementation **/
+
+template <typename Fill>
+bool LogRing::TryWrite(std::size_t size, Fill&& fill) {
+    const std::size_t total      = Align(sizeof(Prefix) + size);
+    const std::uint64_t head     = head_.load(std::memory_order_relaxed);
+    const std::size_t offset     = head & (capacity_ - 1);
+    const std::size_t contiguous = capacity_ - offset;
+    const std::size_t needed     = total <= contiguous ? total : contiguous + total;
+
+    if (total > capacity_ / 2) {
+        return false;
+    }
+    if (head + needed - cached_tail_ > capacity_) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        if (head + needed - cached_tail_ > capacity_) {
+            return false;
+        }
+    }
+
+    std::byte* at = buffer_.get() + offset;
+    if (total > contiguous) {
+        Prefix skip{static_cast<std::uint32_t>(contiguous), 1};
+        std::memcpy(at, &skip, sizeof(skip));
+        at = buffer_.get();
+    }
+    Prefix prefix{static_cast<std::uint32_t>(total), 0};
+    std::memcpy(at, &prefix, sizeof(prefix));
+    fill(at + sizeof(Prefix));
+
+    head_.store(head + needed, std::memory_order_release);
+    return true;
+}
+
+template <typename Consume>
+std::size_t LogRing::Drain(Consume&& consume) {
+    std::uint64_t tail       = tail_.load(std::memory_order_relaxed);
+    const std::uint64_t head = head_.load(std::memory_order_acquire);
+
+    std::size_t count = 0;
+    while (tail != head) {
+        const std::byte* at = buffer_.get() + (tail & (capacity_ - 1));
+        Prefix prefix;
+        std::memcpy(&prefix, at, sizeof(prefix));
+        if (prefix.skip == 0) {
+            consume(at + sizeof(Prefix), prefix.size - sizeof(Prefix));
+            ++count;
+        }
+        tail += prefix.size;
+        tail_.store(tail, std::memory_order_release);
+    }
+    return count;
+}
+
+}  // namespace eurora::utils
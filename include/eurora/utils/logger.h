@@ -1,11 +1,20 @@
 #pragma once
 
-#include <filesystem>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <format>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
+#include "eurora/utils/async_log.h"
 #include "eurora/utils/export_macros.h"
 #include "eurora/utils/logger_level.h"
 #include "utils/pattern/singleton.hpp"
@@ -13,6 +22,26 @@
 namespace eurora::utils {
 
 class LoggerImpl;
+class AsyncLogFrontend;
+
+/// A subsystem whose statements can be leveled apart from the rest; see Logger::SetModuleLevel.
+class LogModule {
+public:
+    explicit LogModule(std::string name, LogLevel level = LogLevel::Trace) : name_(std::move(name)), level_(level) {}
+
+    const std::string& name() const { return name_; }
+
+    LogLevel level() const { return level_.load(std::memory_order_relaxed); }
+
+    bool ShouldLog(LogLevel level) const { return level >= level_.load(std::memory_order_relaxed); }
+
+private:
+    friend class Logger;
+
+    const std::string name_;
+    std::atomic<LogLevel> level_;
+    bool overridden_ = false;  // Otherwise follows the global level. Guarded by Logger's module mutex.
+};
 
 class EURORA_API Logger final : public Singleton<Logger> {
     friend class Singleton<Logger>;
@@ -27,21 +56,80 @@ public:
 
     void Shutdown();
 
+    /// Whether the global level lets `level` through. One relaxed atomic load, before any argument is formatted.
+    bool ShouldLog(LogLevel level) const { return default_module_.ShouldLog(level); }
+
     template <typename... Args>
-    void Logf(const char* file, int line, const char* function, LogLevel level, std::format_string<Args...> fmt, Args&&... args) {
-        Log(file, line, function, level, std::format(fmt, std::forward<Args>(args)...));
-    }
+    void Logf(const char* file, int line, const char* function, LogLevel level, std::format_string<Args...> fmt, Args&&... args);
 
     void Log(const char* file, int line, const char* function, LogLevel level, const std::string& message);
 
+    /// Sets the global level, which every module without a level of its own follows.
     void SetLevel(LogLevel level);
 
     LogLevel GetLevel() const;
 
     void FlushOn(LogLevel lvl);
 
+    /**
+     * The module called `name`, registered on first use. Translation units compiled with EURORA_LOG_MODULE="name"
+     * check their statements against it; the rest use the global level. The reference stays valid for the
+     * lifetime of the Logger.
+     */
+    const LogModule& Module(std::string_view name);
+
+    /// Gives a module its own level, e.g. Trace for one subsystem while everything else stays at Info.
+    void SetModuleLevel(std::string_view name, LogLevel level);
+
+    /// Makes a module follow the global level again.
+    void ResetModuleLevel(std::string_view name);
+
+    const LogModule& DefaultModule() const { return default_module_; }
+
+    static constexpr std::size_t kDefaultRingBytes = 256 * 1024;
+
+    /**
+     * Moves formatting off the calling threads. Logf statements whose arguments are numbers, enums, pointers or
+     * strings are then copied into a per-thread lock-free ring and formatted by a background thread; other
+     * statements are still formatted in place. A full ring drops the statement and counts it rather than blocking.
+     *
+     * Enable and disable while no other thread is logging, e.g. next to InitFromConfig and Shutdown.
+     */
+    void EnableAsync(std::size_t ring_bytes_per_thread = kDefaultRingBytes);
+
+    /// Writes out what is queued and goes back to formatting on the calling thread.
+    void DisableAsync();
+
+    /// Blocks until every queued statement has reached the sinks.
+    void Flush();
+
+    /// Statements dropped because their thread's ring was full.
+    std::uint64_t DroppedRecords() const;
+
+private:
+    template <typename... Args>
+    void Enqueue(const char* file, int line, const char* function, LogLevel level, std::string_view fmt, const Args&... args);
+
+    LogRing* ThreadRing();
+
+    void CountDropped();
+
+    LogModule& FindOrAddModule(std::string_view name);
+
+    /// Propagates the global level to modules that follow it and lowers the backend to the most verbose level in use.
+    void ApplyLevels();
+
 private:
     std::unique_ptr<LoggerImpl> impl_;
+    bool initialized_ = false;
+
+    LogModule default_module_{""};                  // Holds the global level; Trace until initialized.
+    std::atomic<LogLevel> floor_{LogLevel::Trace};  // The most verbose level any module lets through.
+    std::mutex modules_mutex_;
+    std::map<std::string, std::unique_ptr<LogModule>, std::less<>> modules_;
+
+    std::atomic<bool> async_{false};
+    std::unique_ptr<AsyncLogFrontend> frontend_;
 
 public:
     /// let logger like stream
@@ -58,7 +146,7 @@ public:
         }
 
     private:
-        void Flush() { Logger::Instance().Log(file_, line_, function_, level_, stream_.str().c_str()); }
+        void Flush() { Logger::Instance().Logf(file_, line_, function_, level_, "{}", stream_.str()); }
 
     private:
         const char* file_;
@@ -69,26 +157,127 @@ public:
     };
 };
 
-#define __FILENAME__ (std::filesystem::path(__FILE__).filename().string().c_str())
+/** Implementation **/
 
-#define LOG(level, fmt, ...) eurora::utils::Logger::Instance().Logf(__FILENAME__, __LINE__, __FUNCTION__, level, fmt, ##__VA_ARGS__)
+template <typename... Args>
+void Logger::Logf(const char* file, int line, const char* function, LogLevel level, std::format_string<Args...> fmt, Args&&... args) {
+    // The macros already checked the statement's module; this only stops direct callers below every module's level.
+    if (level < floor_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if constexpr ((detail::LogRecordArg<std::remove_cvref_t<Args>> && ...)) {
+        if (async_.load(std::memory_order_relaxed)) {
+            Enqueue<std::remove_cvref_t<Args>...>(file, line, function, level, fmt.get(), args...);
+            if (level == LogLevel::Fatal) {
+                Flush();
+            }
+            return;
+        }
+    }
+    Log(file, line, function, level, std::format(fmt, std::forward<Args>(args)...));
+}
+
+template <typename... Args>
+void Logger::Enqueue(const char* file, int line, const char* function, LogLevel level, std::string_view fmt, const Args&... args) {
+    const auto now         = std::chrono::system_clock::now().time_since_epoch();
+    const std::size_t size = sizeof(LogRecord) + (detail::EncodedSize(args) + ... + std::size_t{0});
+
+    bool written = ThreadRing()->TryWrite(size, [&](std::byte* out) {
+        new (out) LogRecord{&detail::FormatRecord<Args...>, fmt, file, function,
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(now).count(), line, level};
+        [[maybe_unused]] std::byte* at = out + sizeof(LogRecord);
+        ((at = detail::Encode(at, args)), ...);
+    });
+    if (!written) {
+        CountDropped();
+    }
+}
 
-#define LOG_TRACE(fmt, ...) LOG(LogLevel::Trace, fmt, ##__VA_ARGS__)
-#define LOG_DEBUG(fmt, ...) LOG(LogLevel::Debug, fmt, ##__VA_ARGS__)
-#define LOG_INFO(fmt, ...) LOG(LogLevel::Info, fmt, ##__VA_ARGS__)
-#define LOG_WARN(fmt, ...) LOG(LogLevel::Warn, fmt, ##__VA_ARGS__)
-#define LOG_ERROR(fmt, ...) LOG(LogLevel::Error, fmt, ##__VA_ARGS__)
-#define LOG_FATAL(fmt, ...) LOG(LogLevel::Fatal, fmt, ##__VA_ARGS__)
+namespace detail {
+
+// Internal linkage, so each translation unit resolves its own module once.
+#ifdef EURORA_LOG_MODULE
+static inline const LogModule& ThisLogModule() {
+    static const LogModule& module = Logger::Instance().Module(EURORA_LOG_MODULE);
+    return module;
+}
+#else
+static inline const LogModule& ThisLogModule() { return Logger::Instance().DefaultModule(); }
+#endif
+
+}  // namespace detail
+
+#define __FILENAME__ (eurora::utils::FileBasename(__FILE__))
+
+// `level` is checked against the translation unit's module before any argument is evaluated.
+#define LOG(level, fmt, ...)                                                                                        \
+    (eurora::utils::detail::ThisLogModule().ShouldLog(level)                                                        \
+         ? eurora::utils::Logger::Instance().Logf(__FILENAME__, __LINE__, __FUNCTION__, level, fmt, ##__VA_ARGS__) \
+         : void())
 
 #define LOG_IF(condition, level, fmt, ...) \
     if (condition) {                       \
         LOG(level, fmt, ##__VA_ARGS__);    \
     }
 
-#define STREAM_TRACE() eurora::utils::Logger::LogStream(__FILENAME__, __LINE__, __FUNCTION__, LogLevel::Trace)
-#define STREAM_DEBUG() eurora::utils::Logger::LogStream(__FILENAME__, __LINE__, __FUNCTION__, LogLevel::Debug)
-#define STREAM_INFO() eurora::utils::Logger::LogStream(__FILENAME__, __LINE__, __FUNCTION__, LogLevel::Info)
-#define STREAM_WARN() eurora::utils::Logger::LogStream(__FILENAME__, __LINE__, __FUNCTION__, LogLevel::Warn)
-#define STREAM_ERROR() eurora::utils::Logger::LogStream(__FILENAME__, __LINE__, __FUNCTION__, LogLevel::Error)
-#define STREAM_FATAL() eurora::utils::Logger::LogStream(__FILENAME__, __LINE__, __FUNCTION__, LogLevel::Fatal)
+// The empty branch skips building the stream when the level is off, and still binds a caller's `else` correctly.
+#define EURORA_LOG_STREAM(level)                                    \
+    if (!eurora::utils::detail::ThisLogModule().ShouldLog(level)) { \
+    } else                                                          \
+        eurora::utils::Logger::LogStream(__FILENAME__, __LINE__, __FUNCTION__, level)
+
+// Compiled-out streams still type check their operands, but never evaluate them.
+#define EURORA_LOG_STREAM_DISABLED \
+    if (true) {                    \
+    } else                         \
+        eurora::utils::Logger::LogStream(nullptr, 0, nullptr, eurora::utils::LogLevel::Trace)
+
+// Levels below EURORA_LOG_ACTIVE_LEVEL compile to nothing; their arguments are never evaluated.
+#if EURORA_LOG_ACTIVE_LEVEL <= EURORA_LOG_LEVEL_TRACE
+#define LOG_TRACE(fmt, ...) LOG(eurora::utils::LogLevel::Trace, fmt, ##__VA_ARGS__)
+#define STREAM_TRACE() EURORA_LOG_STREAM(eurora::utils::LogLevel::Trace)
+#else
+#define LOG_TRACE(fmt, ...) (void)0
+#define STREAM_TRACE() EURORA_LOG_STREAM_DISABLED
+#endif
+
+#if EURORA_LOG_ACTIVE_LEVEL <= EURORA_LOG_LEVEL_DEBUG
+#define LOG_DEBUG(fmt, ...) LOG(eurora::utils::LogLevel::Debug, fmt, ##__VA_ARGS__)
+#define STREAM_DEBUG() EURORA_LOG_STREAM(eurora::utils::LogLevel::Debug)
+#else
+#define LOG_DEBUG(fmt, ...) (void)0
+#define STREAM_DEBUG() EURORA_LOG_STREAM_DISABLED
+#endif
+
+#if EURORA_LOG_ACTIVE_LEVEL <= EURORA_LOG_LEVEL_INFO
+#define LOG_INFO(fmt, ...) LOG(eurora::utils::LogLevel::Info, fmt, ##__VA_ARGS__)
+#define STREAM_INFO() EURORA_LOG_STREAM(eurora::utils::LogLevel::Info)
+#else
+#define LOG_INFO(fmt, ...) (void)0
+#define STREAM_INFO() EURORA_LOG_STREAM_DISABLED
+#endif
+
+#if EURORA_LOG_ACTIVE_LEVEL <= EURORA_LOG_LEVEL_WARN
+#define LOG_WARN(fmt, ...) LOG(eurora::utils::LogLevel::Warn, fmt, ##__VA_ARGS__)
+#define STREAM_WARN() EURORA_LOG_STREAM(eurora::utils::LogLevel::Warn)
+#else
+#define LOG_WARN(fmt, ...) (void)0
+#define STREAM_WARN() EURORA_LOG_STREAM_DISABLED
+#endif
+
+#if EURORA_LOG_ACTIVE_LEVEL <= EURORA_LOG_LEVEL_ERROR
+#define LOG_ERROR(fmt, ...) LOG(eurora::utils::LogLevel::Error, fmt, ##__VA_ARGS__)
+#define STREAM_ERROR() EURORA_LOG_STREAM(eurora::utils::LogLevel::Error)
+#else
+#define LOG_ERROR(fmt, ...) (void)0
+#define STREAM_ERROR() EURORA_LOG_STREAM_DISABLED
+#endif
+
+#if EURORA_LOG_ACTIVE_LEVEL <= EURORA_LOG_LEVEL_FATAL
+#define LOG_FATAL(fmt, ...) LOG(eurora::utils::LogLevel::Fatal, fmt, ##__VA_ARGS__)
+#define STREAM_FATAL() EURORA_LOG_STREAM(eurora::utils::LogLevel::Fatal)
+#else
+#define LOG_FATAL(fmt, ...) (void)0
+#define STREAM_FATAL() EURORA_LOG_STREAM_DISABLED
+#endif
 }  // namespace eurora::utils
@@ -1,7 +1,23 @@
 #pragma once
 
+// Numeric levels for the preprocessor, in the order of LogLevel.
+#define EURORA_LOG_LEVEL_TRACE 0
+#define EURORA_LOG_LEVEL_DEBUG 1
+#define EURORA_LOG_LEVEL_INFO 2
+#define EURORA_LOG_LEVEL_WARN 3
+#define EURORA_LOG_LEVEL_ERROR 4
+#define EURORA_LOG_LEVEL_FATAL 5
+#define EURORA_LOG_LEVEL_OFF 6
+
+// Statements below this level are compiled out, arguments included. Set it per build, e.g. -DEURORA_LOG_ACTIVE_LEVEL=EURORA_LOG_LEVEL_INFO.
+#ifndef EURORA_LOG_ACTIVE_LEVEL
+#define EURORA_LOG_ACTIVE_LEVEL EURORA_LOG_LEVEL_TRACE
+#endif
+
 namespace eurora::utils {
 
 enum class LogLevel { Trace, Debug, Info, Warn, Error, Fatal };
 
+static_assert(static_cast<int>(LogLevel::Trace) == EURORA_LOG_LEVEL_TRACE && static_cast<int>(LogLevel::Fatal) == EURORA_LOG_LEVEL_FATAL);
+
 }
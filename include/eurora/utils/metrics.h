@@ -0,0 +1,235 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "eurora/utils/export_macros.h"
+#include "utils/pattern/singleton.hpp"
+
+namespace eurora::utils {
+
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+/// Number of shards each counter and histogram spreads its updates over; threads are assigned to them round robin.
+inline constexpr std::size_t kMetricShards = 16;
+
+namespace detail {
+
+inline std::atomic<std::size_t> next_metric_shard{0};
+
+inline std::size_t ThisThreadMetricShard() {
+    thread_local const std::size_t shard = next_metric_shard.fetch_add(1, std::memory_order_relaxed) % kMetricShards;
+    return shard;
+}
+
+}  // namespace detail
+
+/// Monotonic count. Increments touch only the calling thread's shard; Value() sums the shards without locking.
+class Counter {
+public:
+    void Increment(std::uint64_t amount = 1) { shards_[detail::ThisThreadMetricShard()].value.fetch_add(amount, std::memory_order_relaxed); }
+
+    std::uint64_t Value() const {
+        std::uint64_t value = 0;
+        for (const auto& shard : shards_) {
+            value += shard.value.load(std::memory_order_relaxed);
+        }
+        return value;
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> value{0};
+    };
+
+    std::array<Shard, kMetricShards> shards_;
+};
+
+/// Value that goes up and down, such as the number of busy workers.
+class Gauge {
+public:
+    void Set(double value) { value_.store(value, std::memory_order_relaxed); }
+
+    void Add(double amount) { value_.fetch_add(amount, std::memory_order_relaxed); }
+
+    double Value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value_{0.0};
+};
+
+/**
+ * HDR histogram of non-negative integers, such as latencies in nanoseconds or sizes in bytes.
+ *
+ * Values below 64 are counted exactly; above that every power of two is split into 32 buckets, so any recorded
+ * value is reproduced within 1/32 of itself over the full 64-bit range. Each shard's buckets are allocated the
+ * first time a thread records into it.
+ */
+class EURORA_API Histogram {
+public:
+    static constexpr int kSubBucketBits         = 6;
+    static constexpr std::size_t kSubBuckets    = std::size_t{1} << kSubBucketBits;
+    static constexpr std::size_t kHalfSubBucket = kSubBuckets / 2;
+    static constexpr std::size_t kBuckets       = (64 - kSubBucketBits + 2) * kHalfSubBucket;
+
+    struct Snapshot {
+        std::uint64_t count = 0;
+        std::uint64_t sum   = 0;
+        std::uint64_t max   = 0;
+        std::vector<std::uint64_t> buckets;
+
+        /// Upper bound of the bucket holding the value at quantile `q` in [0, 1], or 0 when nothing was recorded.
+        std::uint64_t ValueAtQuantile(double q) const;
+    };
+
+    Histogram() = default;
+    ~Histogram();
+
+    Histogram(const Histogram&)            = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    void Record(std::uint64_t value);
+
+    Snapshot TakeSnapshot() const;
+
+    static constexpr std::size_t BucketIndex(std::uint64_t value) {
+        if (value < kSubBuckets) {
+            return value;
+        }
+        const int shift = (63 - std::countl_zero(value)) - (kSubBucketBits - 1);
+        return static_cast<std::size_t>(shift) * kHalfSubBucket + (value >> shift);
+    }
+
+    static constexpr std::uint64_t BucketUpperBound(std::size_t index) {
+        if (index < kSubBuckets) {
+            return index;
+        }
+        const std::size_t shift   = index / kHalfSubBucket - 1;
+        const std::uint64_t first = index % kHalfSubBucket + kHalfSubBucket;
+        return ((first + 1) << shift) - 1;
+    }
+
+private:
+    struct Shard {
+        std::array<std::atomic<std::uint64_t>, kBuckets> buckets{};
+        std::atomic<std::uint64_t> sum{0};
+    };
+
+    Shard& ThisThreadShard();
+
+    std::array<std::atomic<Shard*>, kMetricShards> shards_{};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+/// Records the nanoseconds between its construction and destruction into a histogram.
+class LatencyTimer {
+public:
+    explicit LatencyTimer(Histogram& histogram) : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+
+    ~LatencyTimer() {
+        histogram_.Record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count()));
+    }
+
+    LatencyTimer(const LatencyTimer&)            = delete;
+    LatencyTimer& operator=(const LatencyTimer&) = delete;
+
+private:
+    Histogram& histogram_;
+    const std::chrono::steady_clock::time_point start_;
+};
+
+class MetricsRegistry;
+
+/// Keeps a callback registered with MetricsRegistry::AddGaugeCallback(); the callback is removed on destruction.
+class EURORA_API GaugeCallback {
+public:
+    GaugeCallback() = default;
+    ~GaugeCallback();
+
+    GaugeCallback(GaugeCallback&& other) noexcept : id_(std::exchange(other.id_, 0)) {}
+    GaugeCallback& operator=(GaugeCallback&& other) noexcept;
+
+    GaugeCallback(const GaugeCallback&)            = delete;
+    GaugeCallback& operator=(const GaugeCallback&) = delete;
+
+private:
+    friend class MetricsRegistry;
+
+    explicit GaugeCallback(std::uint64_t id) : id_(id) {}
+
+    std::uint64_t id_ = 0;
+};
+
+/**
+ * Process wide set of named metrics, written out in the Prometheus text exposition format.
+ *
+ * Metrics are created on first use and live as long as the process, so callers can keep the returned reference,
+ * typically in a function-local static. Registration takes a lock; updates and reads of a metric never do.
+ */
+class EURORA_API MetricsRegistry final : public Singleton<MetricsRegistry> {
+    friend class Singleton<MetricsRegistry>;
+
+private:
+    MetricsRegistry(Token);
+
+    ~MetricsRegistry();
+
+public:
+    Counter& GetCounter(std::string_view name, std::string_view help, const MetricLabels& labels = {});
+
+    Gauge& GetGauge(std::string_view name, std::string_view help, const MetricLabels& labels = {});
+
+    /// `scale` converts recorded values to the exported unit, e.g. 1e-9 for nanoseconds exported as seconds.
+    Histogram& GetHistogram(std::string_view name, std::string_view help, const MetricLabels& labels = {}, double scale = 1.0);
+
+    /// Registers a gauge computed on every scrape. Callbacks with the same name and labels are summed.
+    [[nodiscard]] GaugeCallback AddGaugeCallback(std::string_view name, std::string_view help, const MetricLabels& labels,
+                                                 std::function<double()> callback);
+
+    void WritePrometheus(std::ostream& os) const;
+
+    std::string ExportPrometheus() const;
+
+private:
+    friend class GaugeCallback;
+
+    void RemoveGaugeCallback(std::uint64_t id);
+
+    enum class Type;
+    struct Family;
+
+    Family& GetFamily(std::string_view name, std::string_view help, Type type);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<Family>, std::less<>> families_;
+    std::map<std::uint64_t, Family*> callbacks_;
+    std::uint64_t next_callback_id_ = 1;
+};
+
+/// Publishes the depth of a queue, read through its Size() or size(), as eurora_queue_depth{queue="`name`"}.
+template <typename Queue>
+[[nodiscard]] GaugeCallback WatchQueueDepth(std::string name, const Queue& queue) {
+    return MetricsRegistry::Instance().AddGaugeCallback("eurora_queue_depth", "Items waiting in a queue.", {{"queue", std::move(name)}},
+                                                        [&queue]() -> double {
+                                                            if constexpr (requires { queue.Size(); }) {
+                                                                return static_cast<double>(queue.Size());
+                                                            } else {
+                                                                return static_cast<double>(queue.size());
+                                                            }
+                                                        });
+}
+
+}  // namespace eurora::utils
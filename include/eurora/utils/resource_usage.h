@@ -0,0 +1,132 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "eurora/utils/export_macros.h"
+
+namespace eurora::utils {
+
+/// What one unit of work, typically a reconstruction task, has consumed.
+struct ResourceUsage {
+    std::map<std::string, double> stage_seconds;  // Wall time per pipeline stage.
+    double cpu_seconds              = 0.0;
+    std::uint64_t peak_memory_bytes = 0;
+    std::uint64_t bytes_read        = 0;
+    std::uint64_t bytes_written     = 0;
+};
+
+class ResourceAccount;
+
+namespace detail {
+
+/// Charges accumulated by the calling thread and not yet added to its account.
+struct ResourceThreadState {
+    ResourceAccount* account    = nullptr;
+    std::uint64_t bytes_read    = 0;
+    std::uint64_t bytes_written = 0;
+    std::int64_t cpu_start_ns   = 0;
+};
+
+inline thread_local ResourceThreadState resource_thread_state;
+
+}  // namespace detail
+
+/**
+ * Totals of one unit of work, shared by every thread that works on it.
+ *
+ * Threads charge an account through a ResourceScope. Byte counts and CPU time collect in thread-local accumulators
+ * and reach the account when the scope ends or the thread calls ResourceScope::Flush(), so the hot paths that
+ * count bytes never touch shared memory.
+ */
+class EURORA_API ResourceAccount {
+public:
+    ResourceAccount() = default;
+
+    ResourceAccount(const ResourceAccount&)            = delete;
+    ResourceAccount& operator=(const ResourceAccount&) = delete;
+
+    /// The account the calling thread charges, or nullptr outside any ResourceScope.
+    static ResourceAccount* Current() { return detail::resource_thread_state.account; }
+
+    static void CountRead(std::uint64_t bytes) {
+        auto& state = detail::resource_thread_state;
+        if (state.account != nullptr) {
+            state.bytes_read += bytes;
+        }
+    }
+
+    static void CountWritten(std::uint64_t bytes) {
+        auto& state = detail::resource_thread_state;
+        if (state.account != nullptr) {
+            state.bytes_written += bytes;
+        }
+    }
+
+    void AddStage(std::string_view stage, std::chrono::nanoseconds wall_time);
+
+    void AddCpu(std::chrono::nanoseconds cpu_time) { cpu_ns_.fetch_add(cpu_time.count(), std::memory_order_relaxed); }
+
+    void AddBytes(std::uint64_t read, std::uint64_t written) {
+        bytes_read_.fetch_add(read, std::memory_order_relaxed);
+        bytes_written_.fetch_add(written, std::memory_order_relaxed);
+    }
+
+    /// Raises the recorded peak to `bytes` if it is higher.
+    void UpdatePeakMemory(std::uint64_t bytes);
+
+    /// Totals flushed so far; see ResourceScope::Flush() for the calling thread's pending share.
+    ResourceUsage Usage() const;
+
+private:
+    mutable std::mutex stages_mutex_;
+    std::map<std::string, std::chrono::nanoseconds, std::less<>> stages_;
+
+    std::atomic<std::int64_t> cpu_ns_{0};
+    std::atomic<std::uint64_t> peak_memory_{0};
+    std::atomic<std::uint64_t> bytes_read_{0};
+    std::atomic<std::uint64_t> bytes_written_{0};
+};
+
+/// Makes the calling thread charge `account` until destruction, then restores what it charged before.
+class EURORA_API ResourceScope {
+public:
+    explicit ResourceScope(ResourceAccount* account);
+    ~ResourceScope();
+
+    ResourceScope(const ResourceScope&)            = delete;
+    ResourceScope& operator=(const ResourceScope&) = delete;
+
+    /// Adds the calling thread's pending bytes and CPU time to the account it charges.
+    static void Flush();
+
+private:
+    ResourceAccount* previous_;
+};
+
+/// Adds the wall time between its construction and destruction to a stage of the current account, if there is one.
+class StageTimer {
+public:
+    explicit StageTimer(std::string_view stage) : account_(ResourceAccount::Current()), stage_(stage), start_(std::chrono::steady_clock::now()) {}
+
+    ~StageTimer() {
+        if (account_ != nullptr) {
+            account_->AddStage(stage_, std::chrono::steady_clock::now() - start_);
+        }
+    }
+
+    StageTimer(const StageTimer&)            = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+private:
+    ResourceAccount* const account_;
+    const std::string_view stage_;
+    const std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace eurora::utils
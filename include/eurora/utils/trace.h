@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include "eurora/utils/export_macros.h"
+#include "utils/pattern/singleton.hpp"
+
+namespace eurora::utils {
+
+/// One finished span. Names and categories must outlive the tracer, which string literals and __FUNCTION__ do.
+struct TraceEvent {
+    const char* category;
+    const char* name;
+    std::int64_t start_ns;  // steady_clock
+    std::int64_t duration_ns;
+    const char* arg_name;  // nullptr when the span carries no value
+    std::int64_t arg_value;
+};
+
+/**
+ * Records spans into per-thread, append-only buffers and writes them out in the Chrome trace event format, which
+ * chrome://tracing and ui.perfetto.dev both open.
+ *
+ * Recording is off until Start(); until then a span costs one relaxed atomic load. While recording, a span costs
+ * two clock reads and an uncontended append, and threads never wait on each other or on an export in progress.
+ */
+class EURORA_API Tracer final : public Singleton<Tracer> {
+    friend class Singleton<Tracer>;
+
+private:
+    Tracer(Token);
+
+    ~Tracer();
+
+public:
+    static constexpr std::size_t kDefaultEventsPerThread = 1 << 20;
+
+    /// Begins a new session, discarding the previous one. Threads past `max_events_per_thread` drop further spans.
+    void Start(std::size_t max_events_per_thread = kDefaultEventsPerThread);
+
+    /// Stops recording; what was recorded stays available for export until the next Start().
+    void Stop();
+
+    bool Enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    void Record(const TraceEvent& event);
+
+    /// Labels the calling thread's track in exported traces.
+    void SetThreadName(const std::string& name);
+
+    void WriteChromeTrace(std::ostream& os) const;
+
+    bool ExportChromeTrace(const std::string& path) const;
+
+    /// Events recorded in the current session.
+    std::size_t EventCount() const;
+
+    /// Events dropped in the current session because a thread reached its limit.
+    std::uint64_t DroppedEvents() const;
+
+    static std::int64_t Now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+    std::atomic<bool> enabled_{false};
+};
+
+/// Records the time between its construction and destruction as one span, if the tracer was recording at the start.
+class TraceSpan {
+public:
+    TraceSpan(const char* category, const char* name, bool active = true)
+        : category_(category), name_(name), start_ns_(active && Tracer::Instance().Enabled() ? Tracer::Now() : -1) {}
+
+    ~TraceSpan() {
+        if (start_ns_ >= 0) {
+            Tracer::Instance().Record({category_, name_, start_ns_, Tracer::Now() - start_ns_, arg_name_, arg_value_});
+        }
+    }
+
+    TraceSpan(const TraceSpan&)            = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    /// Attaches one value to the span, shown with it in the trace viewer, e.g. the number of bytes moved.
+    void SetArg(const char* name, std::int64_t value) {
+        arg_name_  = name;
+        arg_value_ = value;
+    }
+
+private:
+    const char* category_;
+    const char* name_;
+    const std::int64_t start_ns_;
+    const char* arg_name_   = nullptr;
+    std::int64_t arg_value_ = 0;
+};
+
+#define EURORA_TRACE_CONCAT_IMPL(a, b) a##b
+#define EURORA_TRACE_CONCAT(a, b) EURORA_TRACE_CONCAT_IMPL(a, b)
+
+#define EURORA_TRACE_SCOPE(category, name) ::eurora::utils::TraceSpan EURORA_TRACE_CONCAT(eurora_trace_span_, __LINE__)(category, name)
+#define EURORA_TRACE_FUNCTION(category) EURORA_TRACE_SCOPE(category, __FUNCTION__)
+
+}  // namespace eurora::utils
@@ -0,0 +1,236 @@
+#include <boost/asio.hpp>
+
+#include <cxxopts.hpp>
+#include <nlohmann/json.hpp>
+
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../common/worker_protocol.h"
+#include "eurora/utils/logger.h"
+#include "eurora/utils/resource_usage.h"
+
+extern char** environ;
+
+namespace asio     = boost::asio;
+namespace protocol = eurora::worker;
+using local        = asio::local::stream_protocol;
+using namespace eurora::utils;
+
+namespace {
+
+void Send(local::socket& socket, const nlohmann::json& message) { asio::write(socket, asio::buffer(protocol::EncodeMessage(message))); }
+
+std::string ReplaceAll(std::string text, const std::string& placeholder, const std::string& value) {
+    for (auto pos = text.find(placeholder); pos != std::string::npos; pos = text.find(placeholder, pos + value.size())) {
+        text.replace(pos, placeholder.size(), value);
+    }
+    return text;
+}
+
+// Splits the command template into arguments at whitespace; quotes group an argument that contains spaces. There
+// is no shell involved, so nothing in a substituted file name is ever interpreted.
+std::vector<std::string> SplitCommand(const std::string& command) {
+    std::vector<std::string> arguments;
+    std::string current;
+    bool in_argument = false;
+    char quote       = 0;
+
+    for (char c : command) {
+        if (quote != 0) {
+            if (c == quote) {
+                quote = 0;
+            } else {
+                current += c;
+            }
+        } else if (c == '\'' || c == '"') {
+            quote       = c;
+            in_argument = true;
+        } else if (std::isspace(static_cast<unsigned char>(c))) {
+            if (in_argument) {
+                arguments.push_back(std::move(current));
+                current.clear();
+                in_argument = false;
+            }
+        } else {
+            current += c;
+            in_argument = true;
+        }
+    }
+
+    if (quote != 0) {
+        throw std::invalid_argument("Unterminated quote in reconstruction command: " + command);
+    }
+    if (in_argument) {
+        arguments.push_back(std::move(current));
+    }
+    return arguments;
+}
+
+std::chrono::nanoseconds ToDuration(const timeval& time) { return std::chrono::seconds(time.tv_sec) + std::chrono::microseconds(time.tv_usec); }
+
+// Runs `arguments[0]`, looked up in PATH, with `arguments` as its argv and waits for it. The child's CPU time, peak
+// resident memory and block I/O, which wait4 reports for exactly this child, are charged to `account`. Returns the
+// exit code, 128 + signal if killed.
+int RunCommand(const std::vector<std::string>& arguments, ResourceAccount& account) {
+    std::vector<char*> argv;
+    argv.reserve(arguments.size() + 1);
+    for (const auto& argument : arguments) {
+        argv.push_back(const_cast<char*>(argument.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    pid_t pid = 0;
+    if (int error = ::posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ); error != 0) {
+        throw std::system_error(error, std::generic_category(), "posix_spawnp " + arguments[0]);
+    }
+
+    int status = 0;
+    rusage usage{};
+    while (::wait4(pid, &status, 0, &usage) < 0) {
+        if (errno != EINTR) {
+            throw std::system_error(errno, std::generic_category(), "wait4");
+        }
+    }
+
+    account.AddCpu(ToDuration(usage.ru_utime) + ToDuration(usage.ru_stime));
+    account.UpdatePeakMemory(static_cast<std::uint64_t>(usage.ru_maxrss) * 1024);  // Kilobytes on Linux.
+    account.AddBytes(static_cast<std::uint64_t>(usage.ru_inblock) * 512, static_cast<std::uint64_t>(usage.ru_oublock) * 512);
+
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+}
+
+// Runs the reconstruction command once per input file, with {input} and {output} substituted in its arguments. The
+// files must resolve to paths inside `work_dir`. Every report carries the resources the task has used so far.
+void RunTask(local::socket& socket, const nlohmann::json& task, const std::vector<std::string>& command, const std::filesystem::path& work_dir) {
+    const auto id = task.at("id").get<std::string>();
+
+    if (command.empty()) {
+        Send(socket, {{"type", protocol::kFailed}, {"id", id}, {"error", "No reconstruction command configured for this worker"}});
+        return;
+    }
+
+    ResourceAccount account;
+    ResourceScope scope(&account);
+    auto resources = [&account]() {
+        ResourceScope::Flush();
+        return protocol::EncodeResources(account.Usage());
+    };
+
+    std::vector<std::string> inputs;
+    for (const auto& file : task.at("input_files").get<std::vector<std::string>>()) {
+        auto input = protocol::ResolveWithin(work_dir, file);
+        if (!input) {
+            Send(socket, {{"type", protocol::kFailed}, {"id", id}, {"error", "Input file is outside the storage directory: " + file}});
+            return;
+        }
+        inputs.push_back(input->string());
+    }
+    const auto output_file = task.at("output_file").get<std::string>();
+    const auto output      = protocol::ResolveWithin(work_dir, output_file);
+    if (!output) {
+        Send(socket, {{"type", protocol::kFailed}, {"id", id}, {"error", "Output file is outside the storage directory: " + output_file}});
+        return;
+    }
+
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        std::vector<std::string> arguments;
+        std::string line;
+        for (const auto& argument : command) {
+            arguments.push_back(ReplaceAll(ReplaceAll(argument, "{input}", inputs[i]), "{output}", output->string()));
+            line += (line.empty() ? "" : " ") + arguments.back();
+        }
+        STREAM_INFO() << "Task " << id << ": " << line;
+
+        int exit_code = 0;
+        try {
+            StageTimer stage("reconstruction");
+            exit_code = RunCommand(arguments, account);
+        } catch (const std::system_error& e) {
+            // A command that cannot be started fails the task; letting it escape would restart the worker and retry.
+            Send(socket, {{"type", protocol::kFailed}, {"id", id}, {"error", e.what()}, {"resources", resources()}});
+            return;
+        }
+        if (exit_code != 0) {
+            auto error = "Reconstruction of " + inputs[i] + " exited with code " + std::to_string(exit_code);
+            Send(socket, {{"type", protocol::kFailed}, {"id", id}, {"error", error}, {"resources", resources()}});
+            return;
+        }
+
+        Send(socket, {{"type", protocol::kProgress},
+                      {"id", id},
+                      {"progress", static_cast<double>(i + 1) / static_cast<double>(inputs.size())},
+                      {"resources", resources()}});
+    }
+
+    Send(socket, {{"type", protocol::kDone}, {"id", id}, {"resources", resources()}});
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        cxxopts::Options options("eurora_backend", "Reconstruction worker supervised by the Eurora frontend");
+
+        options.add_options()("h,help", "Print usage");
+        options.add_options()("s,socket", "Local socket of the frontend worker pool", cxxopts::value<std::string>());
+        options.add_options()("w,worker", "Index of this worker in the pool", cxxopts::value<unsigned int>()->default_value("0"));
+        options.add_options()("l,log_config", "Path to logger configuration file", cxxopts::value<std::string>()->default_value(""));
+        options.add_options()("c,command", "Reconstruction command, run without a shell; {input} and {output} are substituted",
+                              cxxopts::value<std::string>()->default_value(""));
+        options.add_options()("d,work_dir", "Directory all task input and output files must be in", cxxopts::value<std::string>()->default_value("."));
+
+        auto result = options.parse(argc, argv);
+
+        if (result.count("help") || !result.count("socket")) {
+            std::cout << options.help() << std::endl;
+            return result.count("help") ? 0 : 1;
+        }
+
+        if (auto log_config = result["log_config"].as<std::string>(); !log_config.empty()) {
+            Logger::Instance().InitFromConfig(log_config);
+        }
+
+        const auto worker   = result["worker"].as<unsigned int>();
+        const auto command  = SplitCommand(result["command"].as<std::string>());
+        const auto work_dir = std::filesystem::path(result["work_dir"].as<std::string>());
+
+        asio::io_context io_context;
+        local::socket socket(io_context);
+        socket.connect(local::endpoint(result["socket"].as<std::string>()));
+        Send(socket, {{"type", protocol::kHello}, {"worker", worker}, {"pid", ::getpid()}});
+
+        // One task at a time: the frontend only sends the next task after done or failed.
+        std::string buffer;
+        while (true) {
+            auto length  = asio::read_until(socket, asio::dynamic_buffer(buffer), '\n');
+            auto message = nlohmann::json::parse(buffer.substr(0, length - 1));
+            buffer.erase(0, length);
+
+            const auto type = message.at("type").get<std::string>();
+            if (type == protocol::kShutdown) {
+                break;
+            }
+            if (type == protocol::kTask) {
+                RunTask(socket, message, command, work_dir);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <boost/asio/buffer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace eurora::client {
+
+/**
+ * Recycles receive buffers so large payloads are read without a fresh allocation per message.
+ * Blocks are allocated uninitialised; callers always overwrite them completely.
+ */
+class BufferPool {
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t capacity = 0;
+    };
+
+    struct State {
+        std::mutex mutex;
+        std::vector<Block> free_blocks;
+        std::size_t max_cached;
+    };
+
+public:
+    /// Buffer borrowed from a pool; the block goes back to the pool when this is destroyed.
+    class PooledBuffer {
+    public:
+        PooledBuffer() = default;
+
+        PooledBuffer(std::shared_ptr<State> state, Block block, std::size_t size) : state_(std::move(state)), block_(std::move(block)), size_(size) {}
+
+        PooledBuffer(PooledBuffer&&) noexcept = default;
+
+        PooledBuffer& operator=(PooledBuffer&& other) noexcept {
+            if (this != &other) {
+                Release();
+                state_ = std::move(other.state_);
+                block_ = std::move(other.block_);
+                size_  = std::exchange(other.size_, 0);
+            }
+            return *this;
+        }
+
+        PooledBuffer(const PooledBuffer&)            = delete;
+        PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+        ~PooledBuffer() { Release(); }
+
+        std::byte* data() { return block_.data.get(); }
+
+        const std::byte* data() const { return block_.data.get(); }
+
+        std::size_t size() const { return size_; }
+
+        boost::asio::mutable_buffer buffer() { return boost::asio::buffer(data(), size_); }
+
+    private:
+        void Release() {
+            if (!state_ || !block_.data) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            if (state_->free_blocks.size() < state_->max_cached) {
+                state_->free_blocks.push_back(std::move(block_));
+            }
+        }
+
+        std::shared_ptr<State> state_;
+        Block block_;
+        std::size_t size_ = 0;
+    };
+
+    explicit BufferPool(std::size_t max_cached = 8) : state_(std::make_shared<State>()) { state_->max_cached = max_cached; }
+
+    /// Returns a buffer of exactly `size` usable bytes, reusing the smallest cached block that fits.
+    PooledBuffer Acquire(std::size_t size) {
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            auto& blocks = state_->free_blocks;
+            auto best    = blocks.end();
+            for (auto it = blocks.begin(); it != blocks.end(); ++it) {
+                if (it->capacity >= size && (best == blocks.end() || it->capacity < best->capacity)) {
+                    best = it;
+                }
+            }
+            if (best != blocks.end()) {
+                Block block = std::move(*best);
+                blocks.erase(best);
+                return PooledBuffer(state_, std::move(block), size);
+            }
+        }
+        return PooledBuffer(state_, Block{std::make_unique_for_overwrite<std::byte[]>(std::max<std::size_t>(size, 1)), size}, size);
+    }
+
+private:
+    std::shared_ptr<State> state_;
+};
+
+using PooledBuffer = BufferPool::PooledBuffer;
+
+}  // namespace eurora::client
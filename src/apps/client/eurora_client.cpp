@@ -0,0 +1,124 @@
+#include "eurora_client.h"
+
+#include <boost/asio/experimental/awaitable_operators.hpp>
+
+#include <array>
+#include <cstring>
+
+#include "eurora/utils/exception.hpp"
+#include "eurora/utils/logger.h"
+
+using namespace eurora::utils;
+
+namespace eurora::client {
+
+boost::asio::awaitable<void> EuroraClientImageReader::read(ServerConnector& connector) {
+    ReceivedImage image;
+    image.header = co_await connector.ReceiveValue<ISMRMRD::ImageHeader>();
+
+    auto attribute_length = co_await connector.ReceiveValue<uint64_t>();
+    if (attribute_length > 0) {
+        image.attributes = co_await connector.ReceiveFixedSize(attribute_length);
+    }
+
+    image.data = co_await connector.ReceiveFixedSize(ImageDataSize(image.header), buffer_pool_);
+
+    // Disk I/O happens on the writer thread, never on the receive path.
+    consumer_->Write(std::move(image));
+}
+
+EuroraClient::EuroraClient(const std::string& host, const std::string& port, std::chrono::milliseconds timeout) : connector_(host, port, timeout) {}
+
+EuroraClient::EuroraClient(std::shared_ptr<boost::asio::io_context> io_context, const std::string& host, const std::string& port,
+                           std::chrono::milliseconds timeout)
+    : connector_(std::move(io_context), host, port, timeout) {}
+
+void EuroraClient::Process(const std::string& config_file, ISMRMRD::Dataset& dataset) { connector_.Run(Session(config_file, dataset)); }
+
+boost::asio::awaitable<void> EuroraClient::Session(const std::string& config_file, ISMRMRD::Dataset& dataset) {
+    using namespace boost::asio::experimental::awaitable_operators;
+
+    std::string xml_header;
+    dataset.readHeader(xml_header);
+
+    co_await Open(config_file, xml_header);
+
+    // Full duplex: images are consumed while acquisitions are still being sent.
+    co_await (SendLoop(dataset) && ReceiveLoop());
+
+    connector_.Close();
+}
+
+boost::asio::awaitable<void> EuroraClient::Open(const std::string& config_file, const std::string& xml_header) {
+    co_await connector_.Connect();
+    co_await SendConfigurationFile(config_file);
+    co_await SendParameters(xml_header);
+}
+
+boost::asio::awaitable<void> EuroraClient::SendConfigurationFile(const std::string& config_file) {
+    GadgetMessageIdentifier id{GADGET_MESSAGE_CONFIG_FILE};
+    GadgetMessageConfigurationFile conf{};
+
+    if (config_file.size() >= sizeof(conf.configuration_file)) {
+        EURORA_THROW_ERROR(ErrorCode::kInvalidArgument, "Configuration file name is too long: " + config_file);
+    }
+    std::memcpy(conf.configuration_file, config_file.data(), config_file.size());
+
+    std::array<boost::asio::const_buffer, 2> buffers{boost::asio::buffer(&id, sizeof(id)), boost::asio::buffer(&conf, sizeof(conf))};
+    co_await connector_.Send(buffers);
+}
+
+boost::asio::awaitable<void> EuroraClient::SendParameters(const std::string& xml_header) {
+    GadgetMessageIdentifier id{GADGET_MESSAGE_PARAMETER_SCRIPT};
+    GadgetMessageScript script{static_cast<uint32_t>(xml_header.size())};
+
+    std::array<boost::asio::const_buffer, 3> buffers{boost::asio::buffer(&id, sizeof(id)), boost::asio::buffer(&script, sizeof(script)),
+                                                     boost::asio::buffer(xml_header)};
+    co_await connector_.Send(buffers);
+}
+
+boost::asio::awaitable<void> EuroraClient::SendAcquisition(const ISMRMRD::Acquisition& acq) {
+    GadgetMessageIdentifier id{GADGET_MESSAGE_ISMRMRD_ACQUISITION};
+
+    std::array<boost::asio::const_buffer, 4> buffers{
+        boost::asio::buffer(&id, sizeof(id)), boost::asio::buffer(&acq.getHead(), sizeof(ISMRMRD::AcquisitionHeader)),
+        boost::asio::buffer(acq.getTrajPtr(), acq.getTrajSize()), boost::asio::buffer(acq.getDataPtr(), acq.getDataSize())};
+    co_await connector_.Send(buffers);
+}
+
+boost::asio::awaitable<void> EuroraClient::SendClose() {
+    GadgetMessageIdentifier id{GADGET_MESSAGE_CLOSE};
+    co_await connector_.Send(boost::asio::buffer(&id, sizeof(id)));
+}
+
+boost::asio::awaitable<void> EuroraClient::SendLoop(ISMRMRD::Dataset& dataset) {
+    const uint32_t num_acquisitions = dataset.getNumberOfAcquisitions();
+
+    ISMRMRD::Acquisition acq;
+    for (uint32_t i = 0; i < num_acquisitions; ++i) {
+        dataset.readAcquisition(i, acq);
+        co_await SendAcquisition(acq);
+    }
+
+    co_await SendClose();
+    STREAM_INFO() << "Sent " << num_acquisitions << " acquisitions.";
+}
+
+boost::asio::awaitable<void> EuroraClient::ReceiveLoop() {
+    while (true) {
+        // The server is silent while it reconstructs, so only the message bodies are bounded by the read deadline.
+        auto id = co_await connector_.WaitForValue<GadgetMessageIdentifier>();
+
+        if (id.id == GADGET_MESSAGE_CLOSE) {
+            break;
+        }
+
+        if (auto it = readers_.find(id.id); it != readers_.end()) {
+            co_await it->second->read(connector_);
+        } else {
+            EURORA_THROW_ERROR(ErrorCode::kNet_ProtocolError, "Unknown message ID received: " + std::to_string(id.id));
+        }
+    }
+}
+
+}  // namespace eurora::client
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <ismrmrd/dataset.h>
+#include <ismrmrd/ismrmrd.h>
+#include <boost/asio.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "buffer_pool.h"
+#include "gadget_messages.h"
+#include "image_writer.h"
+#include "server_connector.h"
+
+namespace eurora::client {
+
+// Abstract base class for message readers
+class EuroraClientMessageReader {
+public:
+    virtual ~EuroraClientMessageReader() = default;
+
+    /// Consumes the payload following the message identifier from `connector`.
+    virtual boost::asio::awaitable<void> read(ServerConnector& connector) = 0;
+};
+
+// Reader for ISMRMRD images, handing each image to a consumer such as AsyncImageWriter
+class EuroraClientImageReader : public EuroraClientMessageReader {
+public:
+    explicit EuroraClientImageReader(std::shared_ptr<ImageConsumer> consumer) : consumer_(std::move(consumer)) {}
+
+    boost::asio::awaitable<void> read(ServerConnector& connector) override;
+
+private:
+    std::shared_ptr<ImageConsumer> consumer_;
+    BufferPool buffer_pool_;
+};
+
+/**
+ * Coroutine based client streaming an ISMRMRD dataset to a reconstruction server.
+ *
+ * Acquisitions are sent by one coroutine while another one dispatches the messages coming back from the
+ * server, so images are handled while the scan is still being uploaded. Both loops share the connection
+ * strand. Every socket operation is bounded by the connector timeout, except the wait for the next message:
+ * the server may legitimately stay silent for a whole reconstruction.
+ */
+class EuroraClient {
+public:
+    EuroraClient(const std::string& host, const std::string& port, std::chrono::milliseconds timeout = std::chrono::seconds(10));
+
+    EuroraClient(std::shared_ptr<boost::asio::io_context> io_context, const std::string& host, const std::string& port,
+                 std::chrono::milliseconds timeout = std::chrono::seconds(10));
+
+    void SetTimeout(std::chrono::milliseconds timeout) { connector_.SetTimeout(timeout); }
+
+    void RegisterReader(uint16_t message_id, std::shared_ptr<EuroraClientMessageReader> reader) { readers_[message_id] = std::move(reader); }
+
+    /// Connects, sends `config_file` and the dataset header, then streams the acquisitions until the server closes.
+    void Process(const std::string& config_file, ISMRMRD::Dataset& dataset);
+
+    /// Building blocks of a session, for callers that drive several clients on a shared io_context.
+    boost::asio::awaitable<void> Open(const std::string& config_file, const std::string& xml_header);
+    boost::asio::awaitable<void> SendAcquisition(const ISMRMRD::Acquisition& acq);
+    boost::asio::awaitable<void> SendClose();
+    boost::asio::awaitable<void> ReceiveLoop();
+    void Close() { connector_.Close(); }
+
+    ServerConnector::Strand& GetStrand() { return connector_.GetStrand(); }
+
+private:
+    boost::asio::awaitable<void> Session(const std::string& config_file, ISMRMRD::Dataset& dataset);
+
+    boost::asio::awaitable<void> SendConfigurationFile(const std::string& config_file);
+    boost::asio::awaitable<void> SendParameters(const std::string& xml_header);
+
+    boost::asio::awaitable<void> SendLoop(ISMRMRD::Dataset& dataset);
+
+private:
+    ServerConnector connector_;
+    std::unordered_map<uint16_t, std::shared_ptr<EuroraClientMessageReader>> readers_;
+};
+
+}  // namespace eurora::client
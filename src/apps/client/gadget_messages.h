@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+namespace eurora::client {
+
+// Message identifiers of the Gadgetron/ISMRMRD streaming protocol.
+enum GadgetMessageId : uint16_t {
+    GADGET_MESSAGE_CONFIG_FILE         = 1,
+    GADGET_MESSAGE_CONFIG_SCRIPT       = 2,
+    GADGET_MESSAGE_PARAMETER_SCRIPT    = 3,
+    GADGET_MESSAGE_CLOSE               = 4,
+    GADGET_MESSAGE_TEXT                = 5,
+    GADGET_MESSAGE_ISMRMRD_ACQUISITION = 1008,
+    GADGET_MESSAGE_ISMRMRD_IMAGE       = 1022,
+    GADGET_MESSAGE_ISMRMRD_WAVEFORM    = 1026,
+};
+
+#pragma pack(push, 1)
+
+struct GadgetMessageIdentifier {
+    uint16_t id;
+};
+
+struct GadgetMessageConfigurationFile {
+    char configuration_file[1024];
+};
+
+struct GadgetMessageScript {
+    uint32_t script_length;
+};
+
+#pragma pack(pop)
+
+}  // namespace eurora::client
@@ -0,0 +1,158 @@
+#include "image_writer.h"
+
+#include <complex>
+#include <cstring>
+#include <filesystem>
+#include <utility>
+
+#include "eurora/utils/exception.hpp"
+#include "eurora/utils/logger.h"
+
+using namespace eurora::utils;
+
+namespace eurora::client {
+
+namespace {
+
+std::size_t DataTypeSize(uint16_t data_type) {
+    switch (data_type) {
+        case ISMRMRD::ISMRMRD_USHORT:
+        case ISMRMRD::ISMRMRD_SHORT:
+            return 2;
+        case ISMRMRD::ISMRMRD_UINT:
+        case ISMRMRD::ISMRMRD_INT:
+        case ISMRMRD::ISMRMRD_FLOAT:
+            return 4;
+        case ISMRMRD::ISMRMRD_DOUBLE:
+        case ISMRMRD::ISMRMRD_CXFLOAT:
+            return 8;
+        case ISMRMRD::ISMRMRD_CXDOUBLE:
+            return 16;
+        default:
+            EURORA_THROW_ERROR(ErrorCode::kData_UnsupportedFormat, "Unsupported ISMRMRD image data type: " + std::to_string(data_type));
+    }
+}
+
+template <typename T>
+void AppendImage(ISMRMRD::Dataset& dataset, const ReceivedImage& received) {
+    ISMRMRD::Image<T> image;
+    image.setHead(received.header);
+    image.setAttributeString(received.attributes);
+    std::memcpy(image.getDataPtr(), received.data.data(), received.data.size());
+
+    dataset.appendImage("image_" + std::to_string(received.header.image_series_index), image);
+}
+
+}  // namespace
+
+std::size_t ImageDataSize(const ISMRMRD::ImageHeader& header) {
+    return static_cast<std::size_t>(header.matrix_size[0]) * header.matrix_size[1] * header.matrix_size[2] * header.channels * DataTypeSize(header.data_type);
+}
+
+IsmrmrdImageSink::IsmrmrdImageSink(const std::string& output_file, const std::string& group) : dataset_(output_file.c_str(), group.c_str(), true) {}
+
+void IsmrmrdImageSink::Write(const ReceivedImage& image) {
+    switch (image.header.data_type) {
+        case ISMRMRD::ISMRMRD_USHORT:
+            return AppendImage<uint16_t>(dataset_, image);
+        case ISMRMRD::ISMRMRD_SHORT:
+            return AppendImage<int16_t>(dataset_, image);
+        case ISMRMRD::ISMRMRD_UINT:
+            return AppendImage<uint32_t>(dataset_, image);
+        case ISMRMRD::ISMRMRD_INT:
+            return AppendImage<int32_t>(dataset_, image);
+        case ISMRMRD::ISMRMRD_FLOAT:
+            return AppendImage<float>(dataset_, image);
+        case ISMRMRD::ISMRMRD_DOUBLE:
+            return AppendImage<double>(dataset_, image);
+        case ISMRMRD::ISMRMRD_CXFLOAT:
+            return AppendImage<std::complex<float>>(dataset_, image);
+        case ISMRMRD::ISMRMRD_CXDOUBLE:
+            return AppendImage<std::complex<double>>(dataset_, image);
+        default:
+            EURORA_THROW_ERROR(ErrorCode::kData_UnsupportedFormat, "Unsupported ISMRMRD image data type: " + std::to_string(image.header.data_type));
+    }
+}
+
+RawImageSink::RawImageSink(const std::string& output_file, std::size_t buffer_size) : buffer_(buffer_size) {
+    // The stream buffer has to be installed before the file is opened to take effect.
+    file_.rdbuf()->pubsetbuf(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    file_.open(output_file, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        EURORA_THROW_ERROR(ErrorCode::kIO_FileOpenFailed, output_file);
+    }
+}
+
+void RawImageSink::Write(const ReceivedImage& image) {
+    uint64_t attribute_length = image.attributes.size();
+
+    file_.write(reinterpret_cast<const char*>(&image.header), sizeof(image.header));
+    file_.write(reinterpret_cast<const char*>(&attribute_length), sizeof(attribute_length));
+    file_.write(image.attributes.data(), static_cast<std::streamsize>(image.attributes.size()));
+    file_.write(reinterpret_cast<const char*>(image.data.data()), static_cast<std::streamsize>(image.data.size()));
+
+    if (!file_) {
+        EURORA_THROW_ERROR(ErrorCode::kIO_WriteError, "Failed to append image to output container");
+    }
+}
+
+void RawImageSink::Flush() { file_.flush(); }
+
+std::unique_ptr<ImageSink> MakeImageSink(const std::string& output_file) {
+    auto extension = std::filesystem::path(output_file).extension().string();
+    if (extension == ".h5" || extension == ".hdf5") {
+        return std::make_unique<IsmrmrdImageSink>(output_file);
+    }
+    return std::make_unique<RawImageSink>(output_file);
+}
+
+AsyncImageWriter::AsyncImageWriter(std::unique_ptr<ImageSink> sink) : sink_(std::move(sink)), thread_([this]() { Run(); }) {}
+
+AsyncImageWriter::~AsyncImageWriter() {
+    try {
+        Close();
+    } catch (const std::exception& e) {
+        STREAM_ERROR() << "Image writer failed: " << e.what();
+    }
+}
+
+void AsyncImageWriter::Write(ReceivedImage image) {
+    if (failed_.load()) {
+        EURORA_THROW_ERROR(ErrorCode::kIO_WriteError, "Image writer stopped after a previous error");
+    }
+    queue_.Push(std::move(image));
+}
+
+void AsyncImageWriter::Close() {
+    if (thread_.joinable()) {
+        queue_.Close();
+        thread_.join();
+    }
+    if (auto error = std::exchange(error_, nullptr)) {
+        std::rethrow_exception(error);
+    }
+}
+
+void AsyncImageWriter::Run() {
+    try {
+        while (true) {
+            auto image = queue_.Pop();
+            sink_->Write(image);
+            ++images_written_;
+        }
+    } catch (const QueueClosed&) {
+    } catch (...) {
+        error_ = std::current_exception();
+        failed_.store(true);
+        queue_.Close();
+        return;
+    }
+
+    try {
+        sink_->Flush();
+    } catch (...) {
+        error_ = std::current_exception();
+    }
+}
+
+}  // namespace eurora::client
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <ismrmrd/dataset.h>
+#include <ismrmrd/ismrmrd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "buffer_pool.h"
+#include "core/thread_safe_queue.hpp"
+
+namespace eurora::client {
+
+/// Size in bytes of the pixel payload described by `header`, honouring data type, z extent and channels.
+std::size_t ImageDataSize(const ISMRMRD::ImageHeader& header);
+
+// Image as received from the server, payload still in wire format.
+struct ReceivedImage {
+    ISMRMRD::ImageHeader header;
+    std::string attributes;
+    PooledBuffer data;
+};
+
+// Receiver of decoded image messages.
+class ImageConsumer {
+public:
+    virtual ~ImageConsumer() = default;
+
+    virtual void Write(ReceivedImage image) = 0;
+};
+
+// Destination that received images are appended to.
+class ImageSink {
+public:
+    virtual ~ImageSink() = default;
+
+    virtual void Write(const ReceivedImage& image) = 0;
+    virtual void Flush()                           = 0;
+};
+
+// Appends images to an ISMRMRD/HDF5 dataset, one image variable per series.
+class IsmrmrdImageSink : public ImageSink {
+public:
+    IsmrmrdImageSink(const std::string& output_file, const std::string& group = "dataset");
+
+    void Write(const ReceivedImage& image) override;
+    void Flush() override {}
+
+private:
+    ISMRMRD::Dataset dataset_;
+};
+
+/**
+ * Writes images to a flat container file, replacing what a previous run left there. Each record is laid out as on the wire:
+ * ImageHeader, uint64 attribute length, attribute string, pixel data.
+ */
+class RawImageSink : public ImageSink {
+public:
+    explicit RawImageSink(const std::string& output_file, std::size_t buffer_size = 4 * 1024 * 1024);
+
+    void Write(const ReceivedImage& image) override;
+    void Flush() override;
+
+private:
+    std::vector<char> buffer_;
+    std::ofstream file_;
+};
+
+/// Picks the ISMRMRD sink for .h5/.hdf5 outputs and the raw container otherwise.
+std::unique_ptr<ImageSink> MakeImageSink(const std::string& output_file);
+
+/**
+ * Moves disk I/O off the receive path: images are queued and written by a background thread.
+ * Errors raised by the sink are rethrown from Close().
+ */
+class AsyncImageWriter : public ImageConsumer {
+public:
+    explicit AsyncImageWriter(std::unique_ptr<ImageSink> sink);
+    ~AsyncImageWriter();
+
+    AsyncImageWriter(const AsyncImageWriter&)            = delete;
+    AsyncImageWriter& operator=(const AsyncImageWriter&) = delete;
+
+    void Write(ReceivedImage image) override;
+
+    /// Drains the queue, flushes the sink and joins the writer thread.
+    void Close();
+
+    std::size_t ImagesWritten() const { return images_written_.load(); }
+
+private:
+    void Run();
+
+private:
+    std::unique_ptr<ImageSink> sink_;
+    core::ThreadSafeQueue<ReceivedImage> queue_;
+    std::atomic<std::size_t> images_written_{0};
+    std::atomic<bool> failed_{false};
+    std::exception_ptr error_;
+    std::thread thread_;
+};
+
+}  // namespace eurora::client
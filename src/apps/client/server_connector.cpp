@@ -1,47 +1,153 @@
 #include "server_connector.h"
 
+#include <array>
+#include <exception>
+
 #include "eurora/utils/logger.h"
 
 using namespace eurora::utils;
 
 namespace eurora::client {
 
-ServerConnector::ServerConnector(const std::string& host, const std::string& port)
-    : io_context_(), resolver_(io_context_), socket_(io_context_), host_(host), port_(port), timeout_(timeout) {}
+namespace {
+
+// Relays the cancellation of the awaiting coroutine to `target` while alive. Reads bind read_cancel_ so the deadline
+// watcher can cancel them, which hides the coroutine's own slot, e.g. the `&&` in EuroraClient::Session() cancelling
+// the receive loop once the send loop fails.
+class CancellationForwarder {
+public:
+    CancellationForwarder(boost::asio::cancellation_slot slot, boost::asio::cancellation_signal& target) : slot_(slot) {
+        if (slot_.is_connected()) {
+            slot_.assign([&target](boost::asio::cancellation_type type) { target.emit(type); });
+        }
+    }
+
+    ~CancellationForwarder() {
+        if (slot_.is_connected()) {
+            slot_.clear();
+        }
+    }
+
+    CancellationForwarder(const CancellationForwarder&)            = delete;
+    CancellationForwarder& operator=(const CancellationForwarder&) = delete;
+
+private:
+    boost::asio::cancellation_slot slot_;
+};
+
+}  // namespace
+
+ServerConnector::ServerConnector(const std::string& host, const std::string& port, std::chrono::milliseconds timeout)
+    : ServerConnector(std::make_shared<boost::asio::io_context>(), host, port, timeout) {}
+
+ServerConnector::ServerConnector(std::shared_ptr<boost::asio::io_context> io_context, const std::string& host, const std::string& port,
+                                 std::chrono::milliseconds timeout)
+    : host_(host),
+      port_(port),
+      timeout_(timeout),
+      io_context_(std::move(io_context)),
+      strand_(boost::asio::make_strand(*io_context_)),
+      resolver_(strand_),
+      socket_(strand_),
+      read_deadline_(strand_, boost::asio::steady_timer::time_point::max()) {}
 
 boost::asio::awaitable<void> ServerConnector::Connect() {
     try {
-        auto endpoints = co_await resolver_.async_resolve(host_, port_, boost::asio::use_awaitable);
+        auto endpoints = co_await WithTimeout(resolver_.async_resolve(host_, port_, boost::asio::use_awaitable), timeout_);
 
-        co_await boost::asio::async_connect(socket_, endpoints, boost::asio::use_awaitable);
+        co_await WithTimeout(boost::asio::async_connect(socket_, endpoints, boost::asio::use_awaitable), timeout_);
+        socket_.set_option(boost::asio::ip::tcp::no_delay(true));
+        boost::asio::co_spawn(strand_, WatchReadDeadline(), boost::asio::detached);
         STREAM_INFO() << "Connection established.";
     } catch (const std::exception& e) {
         STREAM_ERROR() << "Connection failed: " << e.what();
+        throw;
+    }
+}
+
+void ServerConnector::Run(boost::asio::awaitable<void> session) {
+    std::exception_ptr error;
+    boost::asio::co_spawn(strand_, std::move(session), [this, &error](std::exception_ptr e) {
+        error = e;
+        Close();
+    });
+
+    io_context_->restart();
+    io_context_->run();
+
+    if (error) {
+        std::rethrow_exception(error);
     }
 }
 
 boost::asio::awaitable<void> ServerConnector::Send(const std::string& data) {
-    co_await boost::asio::async_write(socket_, boost::asio::buffer(data), boost::asio::use_awaitable);
-    STREAM_INFO() << "Data sent.";
+    co_await WithTimeout(boost::asio::async_write(socket_, boost::asio::buffer(data), boost::asio::use_awaitable), timeout_);
+    STREAM_DEBUG() << "Data sent.";
 }
 
 boost::asio::awaitable<std::string> ServerConnector::Receive() {
     std::array<char, 1024> buffer;
-    auto n = co_await WithTimeout(socket_.get_executor(), socket_.async_read_some(boost::asio::buffer(buffer), boost::asio::use_awaitable), timeout_);
+    boost::system::error_code ec;
+    CancellationForwarder forward((co_await boost::asio::this_coro::cancellation_state).slot(), read_cancel_);
+
+    read_timed_out_ = false;
+    read_deadline_.expires_after(timeout_);
+    auto n = co_await socket_.async_read_some(boost::asio::buffer(buffer), BindReadCancellation(ec));
+    read_deadline_.expires_at(boost::asio::steady_timer::time_point::max());
+
+    ThrowOnReadError(ec);
     co_return std::string(buffer.data(), n);
 }
 
 boost::asio::awaitable<std::string> ServerConnector::ReceiveFixedSize(std::size_t message_size) {
     std::string message(message_size, '\0');
-    std::size_t total_received = 0;
+    co_await ReceiveInto(boost::asio::buffer(message));
+    co_return message;
+}
+
+boost::asio::awaitable<PooledBuffer> ServerConnector::ReceiveFixedSize(std::size_t message_size, BufferPool& pool) {
+    auto message = pool.Acquire(message_size);
+    co_await ReceiveInto(message.buffer());
+    co_return message;
+}
+
+boost::asio::awaitable<void> ServerConnector::ReceiveInto(boost::asio::mutable_buffer buffer) { co_await ReadInto(buffer, timeout_); }
 
-    while (total_received < message_size) {
-        total_received += co_await WithTimeout(
-            socket_.get_executor(),
-            socket_.async_read_some(boost::asio::buffer(message.data() + total_received, message_size - total_received), boost::asio::use_awaitable), timeout_);
+boost::asio::awaitable<void> ServerConnector::ReadInto(boost::asio::mutable_buffer buffer, std::optional<std::chrono::milliseconds> timeout) {
+    boost::system::error_code ec;
+    CancellationForwarder forward((co_await boost::asio::this_coro::cancellation_state).slot(), read_cancel_);
+
+    read_timed_out_ = false;
+    if (timeout) {
+        read_deadline_.expires_after(*timeout);
     }
+    co_await boost::asio::async_read(socket_, buffer, BindReadCancellation(ec));
+    read_deadline_.expires_at(boost::asio::steady_timer::time_point::max());
 
-    co_return message;
+    ThrowOnReadError(ec);
+}
+
+void ServerConnector::ThrowOnReadError(const boost::system::error_code& ec) const {
+    if (ec == boost::asio::error::operation_aborted && read_timed_out_) {
+        EURORA_THROW_ERROR(ErrorCode::kNet_Timeout, "Receive timed out.");
+    }
+    if (ec) {
+        throw boost::system::system_error(ec);
+    }
+}
+
+boost::asio::awaitable<void> ServerConnector::WatchReadDeadline() {
+    while (socket_.is_open()) {
+        if (read_deadline_.expiry() <= boost::asio::steady_timer::clock_type::now()) {
+            read_timed_out_ = true;
+            read_cancel_.emit(boost::asio::cancellation_type::terminal);
+            read_deadline_.expires_at(boost::asio::steady_timer::time_point::max());
+        }
+
+        // Re-arming the deadline from ReceiveInto aborts this wait, so the loop re-evaluates the new expiry.
+        boost::system::error_code ec;
+        co_await read_deadline_.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    }
 }
 
 void ServerConnector::SetTimeout(std::chrono::milliseconds timeout) { timeout_ = timeout; }
@@ -51,6 +157,7 @@ std::chrono::milliseconds ServerConnector::GetTimeout() const { return timeout_;
 void ServerConnector::Close() {
     if (socket_.is_open()) {
         socket_.close();
+        read_deadline_.cancel();
         STREAM_INFO() << "Connection closed.";
     }
 }
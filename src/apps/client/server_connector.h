@@ -1,53 +1,124 @@
 #pragma once
 
-#include <array>
 #include <boost/asio.hpp>
-#include <boost/asio/experimental/parallel_group.hpp>
+#include <boost/asio/experimental/awaitable_operators.hpp>
 #include <chrono>
 #include <coroutine>
+#include <memory>
+#include <optional>
 #include <string>
-#include <variant>
+#include <type_traits>
+
+#include "buffer_pool.h"
+#include "eurora/utils/exception.hpp"
 
 namespace eurora::client {
 
-template <typename Awaitable>
-boost::asio::awaitable<typename Awaitable::value_type> WithTimeout(boost::asio::io_context::executor_type executor, Awaitable awaitable,
-                                                                   std::chrono::milliseconds timeout) {
-    boost::asio::steady_timer timer(executor);
-    timer.expires_after(timeout);
+/**
+ * Races `operation` against a timer on the current coroutine executor.
+ * The losing branch is cancelled; a timeout surfaces as ErrorCode::kNet_Timeout.
+ */
+template <typename T>
+boost::asio::awaitable<T> WithTimeout(boost::asio::awaitable<T> operation, std::chrono::milliseconds timeout) {
+    using namespace boost::asio::experimental::awaitable_operators;
 
-    std::variant<typename Awaitable::value_type, boost::system::error_code> result =
-        co_await boost::asio::experimental::make_parallel_group(std::move(awaitable), timer.async_wait(boost::asio::use_awaitable))
-            .async_wait(boost::asio::experimental::wait_for_one(), boost::asio::use_awaitable);
+    boost::asio::steady_timer timer(co_await boost::asio::this_coro::executor, timeout);
+    auto result = co_await (std::move(operation) || timer.async_wait(boost::asio::use_awaitable));
 
-    if (std::holds_alternative<typename Awaitable::value_type>(result)) {
-        co_return std::get<typename Awaitable::value_type>(result);
-    } else {
-        throw std::runtime_error("Operation timed out.");
+    if (result.index() == 1) {
+        EURORA_THROW_ERROR(eurora::utils::ErrorCode::kNet_Timeout, "Operation timed out.");
+    }
+    if constexpr (!std::is_void_v<T>) {
+        co_return std::get<0>(std::move(result));
     }
 }
 
 class ServerConnector {
 public:
+    using Strand = boost::asio::strand<boost::asio::io_context::executor_type>;
+
     ServerConnector(const std::string& host, const std::string& port, std::chrono::milliseconds timeout = std::chrono::seconds(5));
 
+    /// Shares `io_context` with other connections; the owner of the context is responsible for running it.
+    ServerConnector(std::shared_ptr<boost::asio::io_context> io_context, const std::string& host, const std::string& port,
+                    std::chrono::milliseconds timeout = std::chrono::seconds(5));
+
     boost::asio::awaitable<void> Connect();
     void Close();
 
+    /// Runs `session` on the connection strand until it completes, rethrowing any error it raised.
+    void Run(boost::asio::awaitable<void> session);
+
+    Strand& GetStrand() { return strand_; }
+
     void SetTimeout(std::chrono::milliseconds timeout);
-    std::chrono::milliseconds GetTimeout();
+    std::chrono::milliseconds GetTimeout() const;
 
     boost::asio::awaitable<void> Send(const std::string& data);
+
+    /// Gathers all buffers of a message into a single write.
+    template <typename ConstBufferSequence>
+    boost::asio::awaitable<void> Send(const ConstBufferSequence& buffers) {
+        co_await WithTimeout(boost::asio::async_write(socket_, buffers, boost::asio::use_awaitable), timeout_);
+    }
+
     boost::asio::awaitable<std::string> Receive();
     boost::asio::awaitable<std::string> ReceiveFixedSize(std::size_t message_size);
 
+    /// Fills `buffer` completely from the socket, bounded by the connection read deadline.
+    boost::asio::awaitable<void> ReceiveInto(boost::asio::mutable_buffer buffer);
+
+    /// Reads `message_size` bytes into a buffer borrowed from `pool`.
+    boost::asio::awaitable<PooledBuffer> ReceiveFixedSize(std::size_t message_size, BufferPool& pool);
+
+    /// Reads a trivially copyable value straight off the socket.
+    template <typename T>
+    boost::asio::awaitable<T> ReceiveValue() {
+        static_assert(std::is_trivially_copyable_v<T>, "ReceiveValue requires a trivially copyable type");
+        T value;
+        co_await ReceiveInto(boost::asio::buffer(&value, sizeof(value)));
+        co_return value;
+    }
+
+    /**
+     * Like ReceiveValue(), but without the read deadline. Meant for the identifier of the next message, which the server
+     * may take longer than the timeout to send, e.g. while it reconstructs a scan that is still being uploaded.
+     */
+    template <typename T>
+    boost::asio::awaitable<T> WaitForValue() {
+        static_assert(std::is_trivially_copyable_v<T>, "WaitForValue requires a trivially copyable type");
+        T value;
+        co_await ReadInto(boost::asio::buffer(&value, sizeof(value)), std::nullopt);
+        co_return value;
+    }
+
+private:
+    /// Fills `buffer` completely, cancelled after `timeout` if one is given.
+    boost::asio::awaitable<void> ReadInto(boost::asio::mutable_buffer buffer, std::optional<std::chrono::milliseconds> timeout);
+
+    /// Cancels the pending read once read_deadline_ passes; lives as long as the socket is open.
+    boost::asio::awaitable<void> WatchReadDeadline();
+
+    /// Binds read_cancel_ for the deadline watcher; callers relay their own cancellation with a CancellationForwarder.
+    auto BindReadCancellation(boost::system::error_code& ec) {
+        return boost::asio::bind_cancellation_slot(read_cancel_.slot(), boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    }
+
+    void ThrowOnReadError(const boost::system::error_code& ec) const;
+
 private:
     std::string host_;
     std::string port_;
     std::chrono::milliseconds timeout_;
-    boost::asio::io_context io_context_;
+    std::shared_ptr<boost::asio::io_context> io_context_;
+    Strand strand_;
     boost::asio::ip::tcp::resolver resolver_;
     boost::asio::ip::tcp::socket socket_;
+
+    // One timer and one cancellation signal per connection instead of one timer per read.
+    boost::asio::steady_timer read_deadline_;
+    boost::asio::cancellation_signal read_cancel_;
+    bool read_timed_out_ = false;
 };
 
 }  // namespace eurora::client
@@ -0,0 +1,248 @@
+#include "sharded_client.h"
+
+#include <boost/asio/deferred.hpp>
+#include <boost/asio/experimental/awaitable_operators.hpp>
+#include <boost/asio/experimental/parallel_group.hpp>
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+#include "eurora/utils/exception.hpp"
+#include "eurora/utils/logger.h"
+
+using namespace eurora::utils;
+
+namespace eurora::client {
+
+namespace {
+
+template <typename Header>
+uint16_t EncodingCounter(const Header& header, ShardKey key) {
+    switch (key) {
+        case ShardKey::Slice:
+            return header.slice;
+        case ShardKey::Contrast:
+            return header.contrast;
+        case ShardKey::Phase:
+            return header.phase;
+        case ShardKey::Repetition:
+            return header.repetition;
+        case ShardKey::Set:
+            return header.set;
+        case ShardKey::Average:
+            return header.average;
+    }
+    return 0;
+}
+
+auto MergeOrder(const ReceivedImage& image, ShardKey key) {
+    return std::make_tuple(ShardKeyValue(image.header, key), image.header.image_series_index, image.header.image_index);
+}
+
+}  // namespace
+
+ShardKey ParseShardKey(const std::string& name) {
+    if (name == "slice") {
+        return ShardKey::Slice;
+    }
+    if (name == "contrast") {
+        return ShardKey::Contrast;
+    }
+    if (name == "phase") {
+        return ShardKey::Phase;
+    }
+    if (name == "repetition") {
+        return ShardKey::Repetition;
+    }
+    if (name == "set") {
+        return ShardKey::Set;
+    }
+    if (name == "average") {
+        return ShardKey::Average;
+    }
+    EURORA_THROW_ERROR(ErrorCode::kInvalidArgument, "Unknown shard key: " + name);
+}
+
+uint16_t ShardKeyValue(const ISMRMRD::AcquisitionHeader& header, ShardKey key) { return EncodingCounter(header.idx, key); }
+
+uint16_t ShardKeyValue(const ISMRMRD::ImageHeader& header, ShardKey key) { return EncodingCounter(header, key); }
+
+class ImageMerger::ShardInput : public ImageConsumer {
+public:
+    ShardInput(std::shared_ptr<ImageMerger> merger, std::size_t shard) : merger_(std::move(merger)), shard_(shard) {}
+
+    void Write(ReceivedImage image) override { merger_->Push(shard_, std::move(image)); }
+
+private:
+    std::shared_ptr<ImageMerger> merger_;
+    std::size_t shard_;
+};
+
+ImageMerger::ImageMerger(std::size_t num_shards, ShardKey key, std::shared_ptr<ImageConsumer> output)
+    : key_(key), output_(std::move(output)), pending_(num_shards), finished_(num_shards, false) {}
+
+std::shared_ptr<ImageConsumer> ImageMerger::Input(std::size_t shard) { return std::make_shared<ShardInput>(shared_from_this(), shard); }
+
+void ImageMerger::Push(std::size_t shard, ReceivedImage image) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_[shard].push_back(std::move(image));
+    Drain();
+}
+
+void ImageMerger::Finish(std::size_t shard) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    finished_[shard] = true;
+    Drain();
+}
+
+void ImageMerger::Drain() {
+    while (true) {
+        std::size_t next = pending_.size();
+        for (std::size_t shard = 0; shard < pending_.size(); ++shard) {
+            if (pending_[shard].empty()) {
+                if (!finished_[shard]) {
+                    return;  // This shard may still produce an image that sorts first.
+                }
+                continue;
+            }
+            if (next == pending_.size() || MergeOrder(pending_[shard].front(), key_) < MergeOrder(pending_[next].front(), key_)) {
+                next = shard;
+            }
+        }
+
+        if (next == pending_.size()) {
+            return;
+        }
+
+        output_->Write(std::move(pending_[next].front()));
+        pending_[next].pop_front();
+    }
+}
+
+ShardedClient::ShardedClient(const std::vector<Endpoint>& backends, std::size_t num_shards, ShardKey key, std::shared_ptr<ImageConsumer> output,
+                             std::chrono::milliseconds timeout)
+    : io_context_(std::make_shared<boost::asio::io_context>()), key_(key), merger_(std::make_shared<ImageMerger>(num_shards, key, std::move(output))) {
+    if (backends.empty() || num_shards == 0) {
+        EURORA_THROW_ERROR(ErrorCode::kInvalidArgument, "Sharding needs at least one backend and one shard");
+    }
+
+    for (std::size_t i = 0; i < num_shards; ++i) {
+        const auto& backend = backends[i % backends.size()];
+        auto shard          = std::make_unique<EuroraClient>(io_context_, backend.host, backend.port, timeout);
+        shard->RegisterReader(GADGET_MESSAGE_ISMRMRD_IMAGE, std::make_shared<EuroraClientImageReader>(merger_->Input(i)));
+        shards_.push_back(std::move(shard));
+    }
+}
+
+void ShardedClient::Process(const std::string& config_file, ISMRMRD::Dataset& dataset) {
+    boost::asio::co_spawn(*io_context_, Session(config_file, dataset), [this](std::exception_ptr e) {
+        if (e) {
+            Fail(e);
+        }
+    });
+
+    // Single threaded: all shard strands are serviced by this one run() call.
+    io_context_->restart();
+    io_context_->run();
+
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+boost::asio::awaitable<void> ShardedClient::Session(const std::string& config_file, ISMRMRD::Dataset& dataset) {
+    using namespace boost::asio::experimental::awaitable_operators;
+
+    std::string xml_header;
+    dataset.readHeader(xml_header);
+
+    for (auto& shard : shards_) {
+        co_await shard->Open(config_file, xml_header);
+    }
+
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+        boost::asio::co_spawn(shards_[i]->GetStrand(), shards_[i]->ReceiveLoop(), [this, i](std::exception_ptr e) {
+            if (e) {
+                Fail(e);
+                return;
+            }
+            merger_->Finish(i);
+            shards_[i]->Close();
+        });
+    }
+
+    for (auto& shard : shards_) {
+        queues_.push_back(std::make_unique<AcquisitionQueue>(shard->GetStrand(), kQueueDepth));
+    }
+
+    co_await (ReadLoop(dataset) && JoinSendLoops());
+}
+
+boost::asio::awaitable<void> ShardedClient::ReadLoop(ISMRMRD::Dataset& dataset) {
+    const uint32_t num_acquisitions = dataset.getNumberOfAcquisitions();
+
+    for (uint32_t i = 0; i < num_acquisitions; ++i) {
+        auto acq = std::make_shared<ISMRMRD::Acquisition>();
+        dataset.readAcquisition(i, *acq);
+
+        if (acq->isFlagSet(ISMRMRD::ISMRMRD_ACQ_IS_NOISE_MEASUREMENT)) {
+            for (auto& queue : queues_) {
+                co_await queue->async_send(boost::system::error_code{}, acq, boost::asio::use_awaitable);
+            }
+            continue;
+        }
+
+        co_await queues_[ShardKeyValue(acq->getHead(), key_) % queues_.size()]->async_send(boost::system::error_code{}, acq, boost::asio::use_awaitable);
+    }
+
+    for (auto& queue : queues_) {
+        co_await queue->async_send(boost::system::error_code{}, nullptr, boost::asio::use_awaitable);
+    }
+
+    STREAM_INFO() << "Read " << num_acquisitions << " acquisitions for " << shards_.size() << " shards.";
+}
+
+boost::asio::awaitable<void> ShardedClient::JoinSendLoops() {
+    using SendLoopOperation = decltype(boost::asio::co_spawn(std::declval<ServerConnector::Strand&>(), std::declval<boost::asio::awaitable<void>>(),
+                                                             boost::asio::deferred));
+
+    std::vector<SendLoopOperation> loops;
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+        loops.push_back(boost::asio::co_spawn(shards_[i]->GetStrand(), SendLoop(i), boost::asio::deferred));
+    }
+
+    // The first failure cancels the remaining loops; it is the error reported.
+    auto [order, errors] = co_await boost::asio::experimental::make_parallel_group(std::move(loops))
+                               .async_wait(boost::asio::experimental::wait_for_one_error(), boost::asio::use_awaitable);
+    for (auto index : order) {
+        if (errors[index]) {
+            std::rethrow_exception(errors[index]);
+        }
+    }
+}
+
+boost::asio::awaitable<void> ShardedClient::SendLoop(std::size_t shard) {
+    std::size_t num_sent = 0;
+    while (auto acq = co_await queues_[shard]->async_receive(boost::asio::use_awaitable)) {
+        co_await shards_[shard]->SendAcquisition(*acq);
+        ++num_sent;
+    }
+
+    co_await shards_[shard]->SendClose();
+    STREAM_INFO() << "Sent " << num_sent << " acquisitions to shard " << shard << ".";
+}
+
+void ShardedClient::Fail(std::exception_ptr error) {
+    if (!error_) {
+        error_ = error;
+    }
+    for (auto& queue : queues_) {
+        queue->close();
+    }
+    for (auto& shard : shards_) {
+        shard->Close();
+    }
+}
+
+}  // namespace eurora::client
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <ismrmrd/dataset.h>
+#include <ismrmrd/ismrmrd.h>
+#include <boost/asio.hpp>
+#include <boost/asio/experimental/channel.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "eurora_client.h"
+#include "image_writer.h"
+
+namespace eurora::client {
+
+// Encoding counter used to split a scan into independently reconstructable shards.
+enum class ShardKey { Slice, Contrast, Phase, Repetition, Set, Average };
+
+ShardKey ParseShardKey(const std::string& name);
+
+uint16_t ShardKeyValue(const ISMRMRD::AcquisitionHeader& header, ShardKey key);
+uint16_t ShardKeyValue(const ISMRMRD::ImageHeader& header, ShardKey key);
+
+/**
+ * K-way merge of the image streams returned by the shards.
+ *
+ * Images are ordered by (shard key, series, image index). An image is only released once every shard that is
+ * still open has an image pending, so the output order does not depend on which backend happens to be faster.
+ */
+class ImageMerger : public std::enable_shared_from_this<ImageMerger> {
+public:
+    ImageMerger(std::size_t num_shards, ShardKey key, std::shared_ptr<ImageConsumer> output);
+
+    /// Consumer to register as the image reader output of shard `shard`.
+    std::shared_ptr<ImageConsumer> Input(std::size_t shard);
+
+    /// Marks `shard` as complete and releases whatever it was holding back.
+    void Finish(std::size_t shard);
+
+private:
+    class ShardInput;
+
+    void Push(std::size_t shard, ReceivedImage image);
+    void Drain();
+
+private:
+    ShardKey key_;
+    std::shared_ptr<ImageConsumer> output_;
+
+    std::mutex mutex_;
+    std::vector<std::deque<ReceivedImage>> pending_;
+    std::vector<bool> finished_;
+};
+
+/**
+ * Streams a dataset over several connections at once, one EuroraClient per shard.
+ *
+ * Acquisitions are routed by `ShardKeyValue(header, key) % num_shards`; noise measurements go to every shard
+ * since each backend needs them for prewhitening. Shards are spread round-robin over the given backends and
+ * all connections share one io_context. Every shard has its own send loop fed through a queue of up to
+ * kQueueDepth acquisitions, so a slow or backpressured backend only holds up the others once its queue is full.
+ */
+class ShardedClient {
+public:
+    struct Endpoint {
+        std::string host;
+        std::string port;
+    };
+
+    ShardedClient(const std::vector<Endpoint>& backends, std::size_t num_shards, ShardKey key, std::shared_ptr<ImageConsumer> output,
+                  std::chrono::milliseconds timeout = std::chrono::seconds(10));
+
+    void Process(const std::string& config_file, ISMRMRD::Dataset& dataset);
+
+    static constexpr std::size_t kQueueDepth = 256;
+
+private:
+    // Acquisitions waiting to be sent to one shard; a null pointer ends the shard's stream.
+    using AcquisitionQueue = boost::asio::experimental::channel<void(boost::system::error_code, std::shared_ptr<const ISMRMRD::Acquisition>)>;
+
+    boost::asio::awaitable<void> Session(const std::string& config_file, ISMRMRD::Dataset& dataset);
+    boost::asio::awaitable<void> ReadLoop(ISMRMRD::Dataset& dataset);
+    boost::asio::awaitable<void> JoinSendLoops();
+    boost::asio::awaitable<void> SendLoop(std::size_t shard);
+
+    void Fail(std::exception_ptr error);
+
+private:
+    std::shared_ptr<boost::asio::io_context> io_context_;
+    ShardKey key_;
+    std::shared_ptr<ImageMerger> merger_;
+    std::vector<std::unique_ptr<EuroraClient>> shards_;
+    std::vector<std::unique_ptr<AcquisitionQueue>> queues_;
+    std::exception_ptr error_;
+};
+
+}  // namespace eurora::client
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+
+#include "eurora/utils/resource_usage.h"
+
+/**
+ * Frontend <-> backend worker protocol: one JSON object per line over a local stream socket.
+ *
+ *   worker   -> frontend  {"type": "hello", "worker": <index>, "pid": <pid>}
+ *   frontend -> worker    {"type": "task", "id": ..., "input_files": [...], "output_file": ...}
+ *   worker   -> frontend  {"type": "progress", "id": ..., "progress": <0..1>, "resources": {...}}
+ *   worker   -> frontend  {"type": "done", "id": ..., "resources": {...}}
+ *   worker   -> frontend  {"type": "failed", "id": ..., "error": ..., "resources": {...}}
+ *   frontend -> worker    {"type": "shutdown"}
+ *
+ * A worker runs one task at a time and is only sent a new one after reporting done or failed. "resources" is what
+ * the task has consumed so far, see EncodeResources(). The files of a task must lie in the storage directory, see
+ * ResolveWithin(); both ends check this, since the paths come from HTTP clients.
+ */
+namespace eurora::worker {
+
+inline constexpr const char* kHello    = "hello";
+inline constexpr const char* kTask     = "task";
+inline constexpr const char* kProgress = "progress";
+inline constexpr const char* kDone     = "done";
+inline constexpr const char* kFailed   = "failed";
+inline constexpr const char* kShutdown = "shutdown";
+
+inline std::string EncodeMessage(const nlohmann::json& message) { return message.dump() + '\n'; }
+
+inline nlohmann::json EncodeResources(const eurora::utils::ResourceUsage& usage) {
+    return {{"stage_seconds", usage.stage_seconds},
+            {"cpu_seconds", usage.cpu_seconds},
+            {"peak_memory_bytes", usage.peak_memory_bytes},
+            {"bytes_read", usage.bytes_read},
+            {"bytes_written", usage.bytes_written}};
+}
+
+inline eurora::utils::ResourceUsage DecodeResources(const nlohmann::json& json) {
+    eurora::utils::ResourceUsage usage;
+    usage.stage_seconds     = json.value("stage_seconds", std::map<std::string, double>{});
+    usage.cpu_seconds       = json.value("cpu_seconds", 0.0);
+    usage.peak_memory_bytes = json.value("peak_memory_bytes", std::uint64_t{0});
+    usage.bytes_read        = json.value("bytes_read", std::uint64_t{0});
+    usage.bytes_written     = json.value("bytes_written", std::uint64_t{0});
+    return usage;
+}
+
+/**
+ * `path` resolved against `root`, with "." and ".." removed and existing symlinks followed, or nothing if the result
+ * lies outside `root`.
+ */
+inline std::optional<std::filesystem::path> ResolveWithin(const std::filesystem::path& root, const std::filesystem::path& path) {
+    std::error_code ec;
+    auto base = std::filesystem::weakly_canonical(root, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    if (!base.has_filename()) {
+        base = base.parent_path();  // "/data/storage/" ends in an empty element.
+    }
+
+    auto resolved = std::filesystem::weakly_canonical(base / path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    auto [base_end, resolved_end] = std::mismatch(base.begin(), base.end(), resolved.begin(), resolved.end());
+    if (base_end != base.end() || resolved_end == resolved.end()) {
+        return std::nullopt;
+    }
+    return resolved;
+}
+
+}  // namespace eurora::worker
@@ -18,6 +18,9 @@ Config Config::Parse(int argc, char* argv[]) {
     options.add_options()("s,storage_dir", "Set storage directory", cxxopts::value<std::string>()->default_value("./storage"));
     options.add_options()("p,port", "Set server port", cxxopts::value<unsigned short>()->default_value("9002"));
     options.add_options()("b,backend_instances", "Number of backend instances", cxxopts::value<unsigned int>()->default_value("1"));
+    options.add_options()("backend_executable", "Path of the backend worker executable", cxxopts::value<std::string>()->default_value(""));
+    options.add_options()("recon_command", "Reconstruction command run by the workers without a shell", cxxopts::value<std::string>()->default_value(""));
+    options.add_options()("t,http_threads", "Number of threads serving HTTP requests", cxxopts::value<unsigned int>()->default_value("4"));
 
     auto result = options.parse(argc, argv);
 
@@ -31,6 +34,9 @@ Config Config::Parse(int argc, char* argv[]) {
     config.log_config        = result["log_config"].as<std::string>();
     config.port              = result["port"].as<unsigned short>();
     config.backend_instances = result["backend_instances"].as<unsigned int>();
+    config.http_threads       = result["http_threads"].as<unsigned int>();
+    config.backend_executable = result["backend_executable"].as<std::string>();
+    config.recon_command      = result["recon_command"].as<std::string>();
 
     if (result.count("config")) {
         auto file_config = Config::LoadFromFile(result["config"].as<std::string>());
@@ -47,6 +53,15 @@ Config Config::Parse(int argc, char* argv[]) {
         if (!result.count("backend_instances")) {
             config.backend_instances = file_config.backend_instances;
         }
+        if (!result.count("http_threads")) {
+            config.http_threads = file_config.http_threads;
+        }
+        if (!result.count("backend_executable")) {
+            config.backend_executable = file_config.backend_executable;
+        }
+        if (!result.count("recon_command")) {
+            config.recon_command = file_config.recon_command;
+        }
     }
 
     return config;
@@ -71,6 +86,15 @@ Config Config::LoadFromFile(const std::string& filename) {
     if (json.contains("backend_instances")) {
         config.backend_instances = json["backend_instances"];
     }
+    if (json.contains("http_threads")) {
+        config.http_threads = json["http_threads"];
+    }
+    if (json.contains("backend_executable")) {
+        config.backend_executable = json["backend_executable"];
+    }
+    if (json.contains("recon_command")) {
+        config.recon_command = json["recon_command"];
+    }
 
     return config;
 }
@@ -9,6 +9,9 @@ struct Config {
     std::string log_config         = "./log_config.json";
     unsigned short port            = 9002;
     unsigned int backend_instances = 1;
+    unsigned int http_threads      = 4;
+    std::string backend_executable;  // Defaults to eurora_backend next to the frontend binary.
+    std::string recon_command;       // Run by the backend workers per input without a shell, {input} and {output} are substituted.
 
     static Config Parse(int argc, char* argv[]);
     static Config LoadFromFile(const std::string& filename);
@@ -0,0 +1,488 @@
+#include "http_server.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../common/worker_protocol.h"
+#include "eurora/utils/logger.h"
+
+namespace eurora::fe {
+
+namespace asio  = boost::asio;
+namespace beast = boost::beast;
+namespace http  = beast::http;
+using tcp       = asio::ip::tcp;
+
+namespace {
+
+constexpr auto kIdleTimeout       = std::chrono::seconds(30);
+constexpr std::size_t kMaxPageSize = 1000;
+
+nlohmann::json ToJson(const TaskManager::Task& task) {
+    nlohmann::json json{
+        {"id", task.id}, {"status", task.status}, {"progress", task.progress}, {"input_files", *task.input_files}, {"output_file", task.output_file}};
+    json["priority"] = std::string(core::ToString(task.priority));
+    if (!task.error.empty()) {
+        json["error"] = task.error;
+    }
+    json["resources"] = worker::EncodeResources(task.resources);
+    return json;
+}
+
+HttpServer::Response MakeResponse(const HttpServer::Request& request, http::status status, std::string body,
+                                  const char* content_type = "application/json") {
+    HttpServer::Response response{status, request.version()};
+    response.set(http::field::server, "eurora");
+    response.set(http::field::content_type, content_type);
+    response.keep_alive(request.keep_alive());
+    response.body() = std::move(body);
+    response.prepare_payload();
+    return response;
+}
+
+HttpServer::Response MakeError(const HttpServer::Request& request, http::status status, const std::string& message) {
+    return MakeResponse(request, status, nlohmann::json{{"error", message}}.dump());
+}
+
+// Splits "/api/tasks/7/progress?x=1" into {"api", "tasks", "7", "progress"}.
+std::vector<std::string_view> SplitPath(std::string_view target) {
+    target = target.substr(0, target.find('?'));
+
+    std::vector<std::string_view> segments;
+    while (!target.empty()) {
+        auto begin = target.find_first_not_of('/');
+        if (begin == std::string_view::npos) {
+            break;
+        }
+        target   = target.substr(begin);
+        auto end = target.find('/');
+        segments.push_back(target.substr(0, end));
+        target = end == std::string_view::npos ? std::string_view{} : target.substr(end);
+    }
+    return segments;
+}
+
+std::vector<std::string_view> SplitPath(const HttpServer::Request& request) {
+    auto target = request.target();
+    return SplitPath(std::string_view(target.data(), target.size()));
+}
+
+// Value of `name` in the query string of the request target, without percent decoding.
+std::optional<std::string> QueryParameter(const HttpServer::Request& request, std::string_view name) {
+    auto target = request.target();
+    auto query  = std::string_view(target.data(), target.size());
+    auto start  = query.find('?');
+    if (start == std::string_view::npos) {
+        return std::nullopt;
+    }
+    query = query.substr(start + 1);
+
+    while (!query.empty()) {
+        auto end  = query.find('&');
+        auto pair = query.substr(0, end);
+        auto eq   = pair.find('=');
+        if (pair.substr(0, eq) == name) {
+            return std::string(eq == std::string_view::npos ? std::string_view{} : pair.substr(eq + 1));
+        }
+        query = end == std::string_view::npos ? std::string_view{} : query.substr(end + 1);
+    }
+    return std::nullopt;
+}
+
+bool IsTaskRoute(const std::vector<std::string_view>& segments) {
+    return segments.size() >= 2 && segments[0] == "api" && segments[1] == "tasks";
+}
+
+}  // namespace
+
+HttpServer::HttpServer(unsigned short port, TaskManager& task_manager, std::filesystem::path storage_dir, std::size_t num_threads)
+    : port_(port),
+      task_manager_(task_manager),
+      storage_dir_(std::move(storage_dir)),
+      num_threads_(num_threads == 0 ? 1 : num_threads),
+      requests_(utils::MetricsRegistry::Instance().GetCounter("eurora_http_requests_total", "HTTP requests received by the frontend.")) {
+    for (const char* status : {TaskManager::kQueued, TaskManager::kRunning, TaskManager::kCompleted, TaskManager::kFailed}) {
+        metrics_.push_back(utils::MetricsRegistry::Instance().AddGaugeCallback(
+            "eurora_tasks", "Reconstruction tasks known to the task manager.", {{"status", status}}, [this, status]() {
+                auto counts = task_manager_.countByStatus();
+                auto it     = counts.find(status);
+                return it == counts.end() ? 0.0 : static_cast<double>(it->second);
+            }));
+    }
+}
+
+HttpServer::~HttpServer() { stop(); }
+
+void HttpServer::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+
+    tcp::acceptor acceptor(io_context_, {tcp::v4(), port_});
+    asio::co_spawn(io_context_, listen(std::move(acceptor)), asio::detached);
+
+    threads_.reserve(num_threads_);
+    for (std::size_t i = 0; i < num_threads_; ++i) {
+        threads_.emplace_back([this]() { io_context_.run(); });
+    }
+
+    STREAM_INFO() << "HTTP server listening on port " << port_ << " with " << num_threads_ << " threads.";
+}
+
+void HttpServer::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    io_context_.stop();
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+    STREAM_INFO() << "HTTP server stopped.";
+}
+
+asio::awaitable<void> HttpServer::listen(tcp::acceptor acceptor) {
+    while (running_) {
+        // Each connection gets its own strand; the handlers of one session never run concurrently.
+        boost::system::error_code ec;
+        auto socket = co_await acceptor.async_accept(asio::make_strand(io_context_), asio::redirect_error(asio::use_awaitable, ec));
+        if (ec) {
+            if (ec == asio::error::operation_aborted) {
+                break;
+            }
+            STREAM_WARN() << "Accept failed: " << ec.message();
+            continue;
+        }
+
+        auto executor = socket.get_executor();
+        asio::co_spawn(executor, session(beast::tcp_stream(std::move(socket))), asio::detached);
+    }
+}
+
+asio::awaitable<void> HttpServer::session(beast::tcp_stream stream) {
+    beast::flat_buffer buffer;
+
+    try {
+        while (true) {
+            Request request;
+            stream.expires_after(kIdleTimeout);
+            co_await http::async_read(stream, buffer, request, asio::use_awaitable);
+            requests_.Increment();
+
+            // Long running routes own the stream until they are done and renew the deadline before every write, so
+            // a client that stops reading is still dropped after kIdleTimeout.
+            auto segments = SplitPath(request);
+            if (request.method() == http::verb::get && IsTaskRoute(segments) && segments.size() == 4) {
+                if (segments[3] == "progress") {
+                    co_await streamProgress(stream, request, std::string(segments[2]));
+                    break;
+                }
+                if (segments[3] == "result") {
+                    co_await sendResult(stream, request, std::string(segments[2]));
+                    if (!request.keep_alive()) {
+                        break;
+                    }
+                    continue;
+                }
+            }
+
+            auto response   = handleRequest(request);
+            bool keep_alive = response.keep_alive();
+            co_await http::async_write(stream, response, asio::use_awaitable);
+            if (!keep_alive) {
+                break;
+            }
+        }
+    } catch (const boost::system::system_error& e) {
+        if (e.code() != http::error::end_of_stream && e.code() != beast::error::timeout && e.code() != asio::error::operation_aborted) {
+            STREAM_WARN() << "HTTP session error: " << e.what();
+        }
+    } catch (const std::exception& e) {
+        STREAM_WARN() << "HTTP session error: " << e.what();
+    }
+
+    beast::error_code ec;
+    stream.socket().shutdown(tcp::socket::shutdown_send, ec);
+}
+
+HttpServer::Response HttpServer::handleRequest(const Request& request) {
+    auto segments = SplitPath(request);
+
+    if (segments.size() == 1 && segments[0] == "health") {
+        return MakeResponse(request, http::status::ok, R"({"status":"ok"})");
+    }
+
+    if (segments.size() == 1 && segments[0] == "metrics" && request.method() == http::verb::get) {
+        return MakeResponse(request, http::status::ok, utils::MetricsRegistry::Instance().ExportPrometheus(), "text/plain; version=0.0.4");
+    }
+
+    if (!IsTaskRoute(segments)) {
+        return MakeError(request, http::status::not_found, "Unknown route");
+    }
+
+    if (segments.size() == 2) {
+        if (request.method() == http::verb::post) {
+            return submitTask(request);
+        }
+        if (request.method() == http::verb::get) {
+            return listTasks(request);
+        }
+    } else if (segments.size() == 3 && request.method() == http::verb::get) {
+        return getTask(request, std::string(segments[2]));
+    }
+
+    return MakeError(request, http::status::method_not_allowed, "Unsupported method");
+}
+
+HttpServer::Response HttpServer::submitTask(const Request& request) {
+    auto body = nlohmann::json::parse(request.body(), nullptr, false);
+    if (body.is_discarded() || !body.is_object() || !body.contains("input_files") || !body["input_files"].is_array() ||
+        !body.contains("output_file") || !body["output_file"].is_string()) {
+        return MakeError(request, http::status::bad_request, "Expected {\"input_files\": [...], \"output_file\": \"...\"}");
+    }
+
+    std::vector<std::string> input_files;
+    for (const auto& file : body["input_files"]) {
+        if (!file.is_string()) {
+            return MakeError(request, http::status::bad_request, "input_files must contain strings");
+        }
+        auto input = worker::ResolveWithin(storage_dir_, file.get<std::string>());
+        if (!input) {
+            return MakeError(request, http::status::bad_request, "Input file is outside the storage directory: " + file.get<std::string>());
+        }
+        input_files.push_back(input->string());
+    }
+
+    auto output_file = worker::ResolveWithin(storage_dir_, body["output_file"].get<std::string>());
+    if (!output_file) {
+        return MakeError(request, http::status::bad_request, "Output file is outside the storage directory: " + body["output_file"].get<std::string>());
+    }
+
+    // Scans waiting on the console are "interactive" and overtake "batch" reprocessing in the worker queue.
+    auto priority = core::TaskPriority::kNormal;
+    if (body.contains("priority")) {
+        auto parsed = body["priority"].is_string() ? core::ParseTaskPriority(body["priority"].get<std::string>()) : std::nullopt;
+        if (!parsed) {
+            return MakeError(request, http::status::bad_request, "priority must be one of \"interactive\", \"normal\" or \"batch\"");
+        }
+        priority = *parsed;
+    }
+
+    auto id = task_manager_.createTask(input_files, output_file->string(), priority);
+    STREAM_INFO() << "Task " << id << " submitted with " << input_files.size() << " input files and " << core::ToString(priority) << " priority.";
+
+    auto response = MakeResponse(request, http::status::created, nlohmann::json{{"id", id}}.dump());
+    response.set(http::field::location, "/api/tasks/" + id);
+    return response;
+}
+
+HttpServer::Response HttpServer::listTasks(const Request& request) {
+    TaskManager::ListQuery query;
+    query.status = QueryParameter(request, "status");
+    try {
+        if (auto after = QueryParameter(request, "after")) {
+            query.after = std::stoull(*after);
+        }
+        if (auto limit = QueryParameter(request, "limit")) {
+            query.limit = std::min<std::size_t>(std::stoul(*limit), kMaxPageSize);
+        }
+    } catch (const std::exception&) {
+        return MakeError(request, http::status::bad_request, "after and limit must be non-negative integers");
+    }
+
+    // The page only holds snapshots, so serialization happens without any task manager lock.
+    auto page  = task_manager_.listTasks(query);
+    auto tasks = nlohmann::json::array();
+    for (const auto& task : page.tasks) {
+        tasks.push_back(ToJson(*task));
+    }
+
+    nlohmann::json body{{"tasks", std::move(tasks)}};
+    if (page.next_cursor != 0) {
+        body["next"] = page.next_cursor;
+    }
+    return MakeResponse(request, http::status::ok, body.dump());
+}
+
+HttpServer::Response HttpServer::getTask(const Request& request, const std::string& id) {
+    auto task = task_manager_.getTask(id);
+    if (!task) {
+        return MakeError(request, http::status::not_found, "Unknown task: " + id);
+    }
+    return MakeResponse(request, http::status::ok, ToJson(*task).dump());
+}
+
+asio::awaitable<void> HttpServer::streamProgress(beast::tcp_stream& stream, const Request& request, const std::string& id) {
+    auto task = task_manager_.getTask(id);
+    if (!task) {
+        auto response = MakeError(request, http::status::not_found, "Unknown task: " + id);
+        response.keep_alive(false);
+        stream.expires_after(kIdleTimeout);
+        co_await http::async_write(stream, response, asio::use_awaitable);
+        co_return;
+    }
+
+    http::response<http::empty_body> response{http::status::ok, request.version()};
+    response.set(http::field::server, "eurora");
+    response.set(http::field::content_type, "application/x-ndjson");
+    response.set(http::field::cache_control, "no-cache");
+    response.keep_alive(false);
+    response.chunked(true);
+
+    http::response_serializer<http::empty_body> serializer{response};
+    stream.expires_after(kIdleTimeout);
+    co_await http::async_write_header(stream, serializer, asio::use_awaitable);
+
+    // Polling the task manager on a timer keeps a waiting client down to one pending timer, no thread.
+    asio::steady_timer timer(stream.get_executor());
+    std::string last_status;
+    double last_progress = -1.0;
+
+    while (task) {
+        if (task->status != last_status || task->progress != last_progress) {
+            last_status   = task->status;
+            last_progress = task->progress;
+
+            auto line = ToJson(*task).dump() + "\n";
+            stream.expires_after(kIdleTimeout);
+            co_await asio::async_write(stream, http::make_chunk(asio::buffer(line)), asio::use_awaitable);
+        }
+
+        if (TaskManager::isFinished(task->status)) {
+            break;
+        }
+
+        timer.expires_after(progress_interval_);
+        co_await timer.async_wait(asio::use_awaitable);
+        task = task_manager_.getTask(id);
+    }
+
+    stream.expires_after(kIdleTimeout);
+    co_await asio::async_write(stream, http::make_chunk_last(), asio::use_awaitable);
+}
+
+asio::awaitable<void> HttpServer::sendResult(beast::tcp_stream& stream, const Request& request, const std::string& id) {
+    auto task = task_manager_.getTask(id);
+
+    // The output path was chosen by the client, so it is checked again here: it may have become a symlink since.
+    std::optional<std::filesystem::path> path;
+    std::optional<Response> error;
+    if (!task) {
+        error = MakeError(request, http::status::not_found, "Unknown task: " + id);
+    } else if (task->status != TaskManager::kCompleted) {
+        error = MakeError(request, http::status::conflict, "Task " + id + " is " + task->status);
+    } else if (path = worker::ResolveWithin(storage_dir_, task->output_file); !path) {
+        error = MakeError(request, http::status::forbidden, "Result of task " + id + " is outside the storage directory");
+    } else if (std::error_code ec; !std::filesystem::is_regular_file(*path, ec)) {
+        error = MakeError(request, http::status::not_found, "Result file is missing for task " + id);
+    }
+
+    stream.expires_after(kIdleTimeout);
+    if (error) {
+        co_await http::async_write(stream, *error, asio::use_awaitable);
+        co_return;
+    }
+
+    const auto filename = path->filename().string();
+
+#if defined(__linux__)
+    int fd = ::open(path->c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+    struct stat status {};
+    if (fd < 0 || ::fstat(fd, &status) != 0 || !S_ISREG(status.st_mode)) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        auto response = MakeError(request, http::status::internal_server_error, "Failed to open result of task " + id);
+        co_await http::async_write(stream, response, asio::use_awaitable);
+        co_return;
+    }
+    struct FileCloser {
+        int fd;
+        ~FileCloser() { ::close(fd); }
+    } closer{fd};
+
+    const off_t size = status.st_size;
+
+    http::response<http::empty_body> response{http::status::ok, request.version()};
+    response.set(http::field::server, "eurora");
+    response.set(http::field::content_type, "application/octet-stream");
+    response.set(http::field::content_disposition, "attachment; filename=\"" + filename + "\"");
+    response.content_length(static_cast<std::uint64_t>(size));
+    response.keep_alive(request.keep_alive());
+
+    http::response_serializer<http::empty_body> serializer{response};
+    co_await http::async_write_header(stream, serializer, asio::use_awaitable);
+
+    // The payload goes from the page cache straight to the socket without passing through user space. Waiting on the
+    // raw socket bypasses the stream's deadline, so a watchdog cancels any wait that sees no progress for kIdleTimeout.
+    auto& socket = stream.socket();
+    socket.native_non_blocking(true);
+    asio::steady_timer watchdog(stream.get_executor());
+    off_t offset = 0;
+    while (offset < size) {
+        ssize_t sent = ::sendfile(socket.native_handle(), fd, &offset, static_cast<std::size_t>(size - offset));
+        if (sent < 0) {
+            if (errno == EAGAIN) {
+                watchdog.expires_after(kIdleTimeout);
+                watchdog.async_wait([&socket](const boost::system::error_code& ec) {
+                    if (!ec) {
+                        socket.cancel();
+                    }
+                });
+                co_await socket.async_wait(tcp::socket::wait_write, asio::use_awaitable);
+                watchdog.cancel();
+                continue;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            throw boost::system::system_error(errno, boost::system::system_category(), "sendfile");
+        }
+        if (sent == 0) {
+            // The file shrank after the header went out; the client can only tell by the connection closing early.
+            throw std::runtime_error("Result of task " + id + " was truncated while it was sent");
+        }
+    }
+#else
+    http::file_body::value_type body;
+    beast::error_code ec;
+    body.open(path->string().c_str(), beast::file_mode::scan, ec);
+    if (ec) {
+        auto response = MakeError(request, http::status::internal_server_error, "Failed to open result of task " + id);
+        co_await http::async_write(stream, response, asio::use_awaitable);
+        co_return;
+    }
+
+    http::response<http::file_body> response{std::piecewise_construct, std::make_tuple(std::move(body)),
+                                             std::make_tuple(http::status::ok, request.version())};
+    response.set(http::field::server, "eurora");
+    response.set(http::field::content_type, "application/octet-stream");
+    response.set(http::field::content_disposition, "attachment; filename=\"" + filename + "\"");
+    response.keep_alive(request.keep_alive());
+    response.prepare_payload();
+
+    // Written piecewise so that the deadline bounds each write, not the whole download.
+    http::response_serializer<http::file_body> serializer{response};
+    while (!serializer.is_done()) {
+        stream.expires_after(kIdleTimeout);
+        co_await http::async_write_some(stream, serializer, asio::use_awaitable);
+    }
+#endif
+}
+
+}  // namespace eurora::fe
@@ -1,18 +1,79 @@
 #pragma once
+
+#include <boost/asio.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
 #include <string>
-#include "TaskManager.h"
+#include <thread>
+#include <vector>
+
+#include "eurora/utils/metrics.h"
+#include "task_manager.h"
 
 namespace eurora::fe {
 
+/**
+ * REST front door of the task manager.
+ *
+ * All connections are served by coroutines on one io_context that is run by a fixed pool of threads, so the
+ * number of OS threads does not grow with the number of clients. Task files are resolved against, and must lie in,
+ * the storage directory. Routes:
+ *
+ *   POST /api/tasks                 submit {"input_files": [...], "output_file": "..."}, answers 201 {"id": ...}
+ *   GET  /api/tasks                 one page of tasks, ordered by id; query: status, after (cursor), limit
+ *   GET  /api/tasks/{id}            status of one task
+ *   GET  /api/tasks/{id}/progress   chunked stream of one JSON line per status change, ends when the task finishes
+ *   GET  /api/tasks/{id}/result     download of the output file of a completed task
+ *   GET  /health                    liveness probe
+ *   GET  /metrics                   every metric of the process, in the Prometheus text format
+ */
 class HttpServer {
 public:
-    HttpServer(unsigned short port, TaskManager& task_manager);
+    using Request  = boost::beast::http::request<boost::beast::http::string_body>;
+    using Response = boost::beast::http::response<boost::beast::http::string_body>;
+
+    HttpServer(unsigned short port, TaskManager& task_manager, std::filesystem::path storage_dir,
+               std::size_t num_threads = std::thread::hardware_concurrency());
+    ~HttpServer();
+
+    HttpServer(const HttpServer&)            = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+
+    /// Binds the port and starts the worker threads; returns immediately.
     void start();
+    /// Stops accepting, cancels pending operations and joins the worker threads.
     void stop();
 
+    void setProgressInterval(std::chrono::milliseconds interval) { progress_interval_ = interval; }
+
+private:
+    boost::asio::awaitable<void> listen(boost::asio::ip::tcp::acceptor acceptor);
+    boost::asio::awaitable<void> session(boost::beast::tcp_stream stream);
+
+    Response handleRequest(const Request& request);
+    Response submitTask(const Request& request);
+    Response listTasks(const Request& request);
+    Response getTask(const Request& request, const std::string& id);
+
+    boost::asio::awaitable<void> streamProgress(boost::beast::tcp_stream& stream, const Request& request, const std::string& id);
+    boost::asio::awaitable<void> sendResult(boost::beast::tcp_stream& stream, const Request& request, const std::string& id);
+
 private:
     unsigned short port_;
     TaskManager& task_manager_;
-    std::atomic<bool> running_;
+    std::filesystem::path storage_dir_;
+    std::size_t num_threads_;
+    std::chrono::milliseconds progress_interval_{500};
+    std::atomic<bool> running_{false};
+
+    boost::asio::io_context io_context_;
+    std::vector<std::thread> threads_;
+
+    eurora::utils::Counter& requests_;
+    std::vector<eurora::utils::GaugeCallback> metrics_;
 };
 }  // namespace eurora::fe
@@ -1,8 +1,18 @@
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/signal_set.hpp>
+
+#include <csignal>
+#include <filesystem>
 #include <iostream>
-#include "HttpServer.h"
-#include "TaskManager.h"
+
 #include "config.h"
 #include "eurora/utils/logger.h"
+#include "http_server.h"
+#include "task_manager.h"
+#include "worker_pool.h"
+
+using namespace eurora::fe;
+using namespace eurora::utils;
 
 int main(int argc, char* argv[]) {
     try {
@@ -14,10 +24,35 @@ int main(int argc, char* argv[]) {
         std::cout << "  Storage Directory: " << config.storage_dir << std::endl;
         std::cout << "  Port: " << config.port << std::endl;
         std::cout << "  Backend Instances: " << config.backend_instances << std::endl;
+        std::cout << "  HTTP Threads: " << config.http_threads << std::endl;
 
-        // TODO: Initialize server and start handling tasks
         Logger::Instance().InitFromConfig(config.log_config);
 
+        WorkerPool::Options worker_options;
+        worker_options.executable = config.backend_executable.empty()
+                                        ? std::filesystem::read_symlink("/proc/self/exe").parent_path() / "eurora_backend"
+                                        : std::filesystem::path(config.backend_executable);
+        worker_options.num_workers = config.backend_instances;
+        worker_options.log_config  = config.log_config;
+        worker_options.command     = config.recon_command;
+        worker_options.work_dir    = config.storage_dir;
+
+        TaskManager task_manager;
+        WorkerPool workers(worker_options, task_manager);
+        task_manager.setCreatedListener([&workers](const TaskManager::TaskPtr& task) { workers.submit(task->id, task->priority); });
+        workers.start();
+
+        HttpServer server(config.port, task_manager, config.storage_dir, config.http_threads);
+        server.start();
+
+        // Block until asked to shut down; requests are served by the server's own threads.
+        boost::asio::io_context signal_context;
+        boost::asio::signal_set signals(signal_context, SIGINT, SIGTERM);
+        signals.async_wait([](const boost::system::error_code&, int signal) { STREAM_INFO() << "Received signal " << signal << ", shutting down."; });
+        signal_context.run();
+
+        server.stop();
+        workers.stop();
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
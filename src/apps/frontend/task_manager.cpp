@@ -0,0 +1,168 @@
+#include "task_manager.h"
+
+#include <algorithm>
+#include <charconv>
+#include <mutex>
+
+namespace eurora::fe {
+
+TaskManager::TaskManager(std::size_t num_shards) : shards_(num_shards == 0 ? 1 : num_shards) {}
+
+std::optional<uint64_t> TaskManager::parseId(const std::string& id) {
+    uint64_t value = 0;
+    auto [end, ec] = std::from_chars(id.data(), id.data() + id.size(), value);
+    if (ec != std::errc() || end != id.data() + id.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::string TaskManager::createTask(const std::vector<std::string>& input_files, const std::string& output_file, core::TaskPriority priority) {
+    const uint64_t seq = ++next_id_;
+
+    auto task         = std::make_shared<Task>();
+    task->id          = std::to_string(seq);
+    task->status      = kQueued;
+    task->input_files = std::make_shared<const std::vector<std::string>>(input_files);
+    task->output_file = output_file;
+    task->priority    = priority;
+
+    {
+        auto& shard = shardFor(seq);
+        std::unique_lock lock(shard.mutex);
+        shard.tasks.emplace(seq, task);
+        shard.by_status[task->status].insert(seq);
+    }
+
+    if (created_listener_) {
+        created_listener_(task);
+    }
+    return task->id;
+}
+
+TaskManager::TaskPtr TaskManager::getTask(const std::string& id) const {
+    auto seq = parseId(id);
+    if (!seq) {
+        return nullptr;
+    }
+
+    const auto& shard = shardFor(*seq);
+    std::shared_lock lock(shard.mutex);
+    if (auto it = shard.tasks.find(*seq); it != shard.tasks.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+template <typename Update>
+void TaskManager::updateTask(const std::string& id, Update&& update) {
+    auto seq = parseId(id);
+    if (!seq) {
+        return;
+    }
+
+    auto& shard = shardFor(*seq);
+    std::unique_lock lock(shard.mutex);
+    auto it = shard.tasks.find(*seq);
+    if (it == shard.tasks.end()) {
+        return;
+    }
+
+    // Copy-on-write: readers holding the old snapshot keep a consistent view. The input file list is shared, so
+    // the copy is a handful of scalars, two short strings and the few stage timings.
+    auto next = std::make_shared<Task>(*it->second);
+    update(*next);
+
+    if (next->status != it->second->status) {
+        auto& previous = shard.by_status[it->second->status];
+        previous.erase(*seq);
+        if (previous.empty()) {
+            shard.by_status.erase(it->second->status);
+        }
+        shard.by_status[next->status].insert(*seq);
+    }
+    it->second = std::move(next);
+}
+
+void TaskManager::updateTaskStatus(const std::string& id, const std::string& status) {
+    updateTask(id, [&status](Task& task) {
+        task.status = status;
+        if (status == kCompleted) {
+            task.progress = 1.0;
+        } else if (status == kQueued) {
+            task.progress = 0.0;
+        }
+    });
+}
+
+void TaskManager::failTask(const std::string& id, const std::string& error) {
+    updateTask(id, [&error](Task& task) {
+        task.status = kFailed;
+        task.error  = error;
+    });
+}
+
+void TaskManager::updateTaskResources(const std::string& id, utils::ResourceUsage resources) {
+    updateTask(id, [&resources](Task& task) { task.resources = std::move(resources); });
+}
+
+void TaskManager::updateTaskProgress(const std::string& id, double progress) {
+    updateTask(id, [progress](Task& task) { task.progress = std::clamp(progress, 0.0, 1.0); });
+}
+
+TaskManager::TaskPage TaskManager::listTasks(const ListQuery& query) const {
+    TaskPage page;
+    if (query.limit == 0) {
+        return page;
+    }
+
+    // Every shard contributes at most `limit + 1` candidates, so a single shard holding more than a page still tells
+    // that there is a next one; only pointers are copied while a shard is locked.
+    const std::size_t per_shard = query.limit + 1;
+    std::vector<std::pair<uint64_t, TaskPtr>> candidates;
+    for (const auto& shard : shards_) {
+        std::shared_lock lock(shard.mutex);
+        std::size_t taken = 0;
+
+        if (query.status) {
+            auto index = shard.by_status.find(*query.status);
+            if (index == shard.by_status.end()) {
+                continue;
+            }
+            for (auto it = index->second.upper_bound(query.after); it != index->second.end() && taken < per_shard; ++it, ++taken) {
+                candidates.emplace_back(*it, shard.tasks.at(*it));
+            }
+        } else {
+            for (auto it = shard.tasks.upper_bound(query.after); it != shard.tasks.end() && taken < per_shard; ++it, ++taken) {
+                candidates.emplace_back(it->first, it->second);
+            }
+        }
+    }
+
+    const bool more = candidates.size() > query.limit;
+    const auto keep = std::min(candidates.size(), query.limit);
+    std::partial_sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(keep), candidates.end(),
+                      [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    page.tasks.reserve(keep);
+    for (std::size_t i = 0; i < keep; ++i) {
+        page.tasks.push_back(std::move(candidates[i].second));
+    }
+    if (more) {
+        page.next_cursor = candidates[keep - 1].first;
+    }
+    return page;
+}
+
+std::map<std::string, std::size_t> TaskManager::countByStatus() const {
+    std::map<std::string, std::size_t> counts;
+    for (const auto& shard : shards_) {
+        std::shared_lock lock(shard.mutex);
+        for (const auto& [status, ids] : shard.by_status) {
+            counts[status] += ids.size();
+        }
+    }
+    return counts;
+}
+
+}  // namespace eurora::fe
@@ -1,32 +1,98 @@
 #pragma once
 
-#include <future>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
-#include <mutex>
 #include <optional>
+#include <set>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "core/priority_task_queue.hpp"
+#include "eurora/utils/resource_usage.h"
+
 namespace eurora::fe {
 
+/**
+ * Registry of reconstruction tasks.
+ *
+ * Tasks are spread over lock-striped shards by id. Every stored task is an immutable snapshot: updates swap in a
+ * new snapshot under the shard lock, so readers only copy a shared_ptr while locked and can serialize at leisure.
+ * Each shard keeps an index by status so filtered listings do not scan unrelated tasks.
+ */
 class TaskManager {
 public:
+    static constexpr const char* kQueued    = "queued";
+    static constexpr const char* kRunning   = "running";
+    static constexpr const char* kCompleted = "completed";
+    static constexpr const char* kFailed    = "failed";
+
     struct Task {
         std::string id;
         std::string status;
-        std::vector<std::string> input_files;
+        // Shared between snapshots of the same task; never changes after submission.
+        std::shared_ptr<const std::vector<std::string>> input_files;
         std::string output_file;
+        core::TaskPriority priority = core::TaskPriority::kNormal;
+        double progress             = 0.0;
+        std::string error;               ///< Reason of failure, empty otherwise.
+        utils::ResourceUsage resources;  ///< As last reported by the worker running the task.
+    };
+
+    using TaskPtr         = std::shared_ptr<const Task>;
+    using CreatedListener = std::function<void(const TaskPtr&)>;
+
+    struct ListQuery {
+        std::optional<std::string> status;  ///< Only tasks in this status.
+        uint64_t after    = 0;              ///< Cursor: only tasks with a larger id.
+        std::size_t limit = 100;
+    };
+
+    struct TaskPage {
+        std::vector<TaskPtr> tasks;  ///< Ordered by id.
+        uint64_t next_cursor = 0;    ///< Value for `ListQuery::after` to fetch the next page, 0 on the last page.
     };
 
-    std::string createTask(const std::vector<std::string>& input_files, const std::string& output_file);
-    std::optional<Task> getTask(const std::string& id);
+    static bool isFinished(const std::string& status) { return status == kCompleted || status == kFailed; }
+
+    explicit TaskManager(std::size_t num_shards = 16);
+
+    std::string createTask(const std::vector<std::string>& input_files, const std::string& output_file,
+                           core::TaskPriority priority = core::TaskPriority::kNormal);
+    TaskPtr getTask(const std::string& id) const;
     void updateTaskStatus(const std::string& id, const std::string& status);
+    void updateTaskProgress(const std::string& id, double progress);
+    void failTask(const std::string& id, const std::string& error);
+    void updateTaskResources(const std::string& id, utils::ResourceUsage resources);
+
+    /// Called outside any lock after each createTask(). Set it before tasks are submitted.
+    void setCreatedListener(CreatedListener listener) { created_listener_ = std::move(listener); }
+
+    TaskPage listTasks(const ListQuery& query) const;
+    std::map<std::string, std::size_t> countByStatus() const;
+
+private:
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::map<uint64_t, TaskPtr> tasks;
+        std::unordered_map<std::string, std::set<uint64_t>> by_status;
+    };
+
+    static std::optional<uint64_t> parseId(const std::string& id);
+
+    Shard& shardFor(uint64_t id) { return shards_[id % shards_.size()]; }
+    const Shard& shardFor(uint64_t id) const { return shards_[id % shards_.size()]; }
 
-    std::vector<Task> listTasks() const;
+    template <typename Update>
+    void updateTask(const std::string& id, Update&& update);
 
 private:
-    mutable std::mutex mutex_;
-    std::unordered_map<std::string, Task> tasks_;
+    std::vector<Shard> shards_;
+    std::atomic<uint64_t> next_id_{0};
+    CreatedListener created_listener_;
 };
 }  // namespace eurora::fe
@@ -0,0 +1,304 @@
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <csignal>
+
+#include <unistd.h>
+
+#include "../common/worker_protocol.h"
+#include "eurora/utils/logger.h"
+
+namespace eurora::fe {
+
+namespace asio     = boost::asio;
+namespace bp       = boost::process;
+namespace protocol = eurora::worker;
+using local        = asio::local::stream_protocol;
+
+namespace {
+
+constexpr auto kShutdownGrace = std::chrono::seconds(5);
+
+}  // namespace
+
+WorkerPool::WorkerPool(Options options, TaskManager& task_manager)
+    : options_(std::move(options)), task_manager_(task_manager), acceptor_(io_context_), shutdown_timer_(io_context_) {}
+
+WorkerPool::~WorkerPool() { stop(); }
+
+void WorkerPool::start() {
+    if (thread_.joinable()) {
+        return;
+    }
+
+    socket_path_ = std::filesystem::temp_directory_path() / ("eurora-fe-" + std::to_string(::getpid()) + ".sock");
+    std::filesystem::remove(socket_path_);
+
+    local::endpoint endpoint(socket_path_.string());
+    acceptor_.open(endpoint.protocol());
+    acceptor_.bind(endpoint);
+    acceptor_.listen();
+
+    running_ = true;
+    workers_.resize(options_.num_workers);
+    for (unsigned int i = 0; i < options_.num_workers; ++i) {
+        spawn(i);
+    }
+
+    asio::co_spawn(io_context_, acceptWorkers(), asio::detached);
+    thread_ = std::thread([this]() { io_context_.run(); });
+
+    STREAM_INFO() << "Started " << options_.num_workers << " backend workers from " << options_.executable.string() << ".";
+}
+
+void WorkerPool::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+
+    asio::post(io_context_, [this]() {
+        running_ = false;
+        boost::system::error_code ec;
+        acceptor_.close(ec);
+
+        bool any_alive = false;
+        for (auto& worker : workers_) {
+            if (!worker.process) {
+                continue;
+            }
+            any_alive = true;
+            if (worker.idle()) {
+                send(worker, protocol::EncodeMessage({{"type", protocol::kShutdown}}));
+            } else {
+                ::kill(worker.process->id(), SIGTERM);
+            }
+        }
+
+        if (!any_alive) {
+            return;
+        }
+
+        // Whatever has not exited by then is killed; the exit handlers drain the io_context afterwards.
+        shutdown_timer_.expires_after(kShutdownGrace);
+        shutdown_timer_.async_wait([this](const boost::system::error_code& ec) {
+            if (ec) {
+                return;
+            }
+            for (auto& worker : workers_) {
+                if (worker.process) {
+                    ::kill(worker.process->id(), SIGKILL);
+                }
+            }
+        });
+    });
+
+    thread_.join();
+    workers_.clear();
+
+    std::error_code ec;
+    std::filesystem::remove(socket_path_, ec);
+    STREAM_INFO() << "Backend workers stopped.";
+}
+
+void WorkerPool::submit(const std::string& id, core::TaskPriority priority) {
+    const auto due = core::DueTime({priority}, std::chrono::steady_clock::now());
+    asio::post(io_context_, [this, id, due]() {
+        pending_.insert({due, next_sequence_++, id});
+        dispatch();
+    });
+}
+
+void WorkerPool::spawn(unsigned int index) {
+    auto& worker            = workers_[index];
+    unsigned int generation = ++worker.generation;
+
+    try {
+        worker.process = std::make_unique<bp::child>(
+            bp::exe = options_.executable.string(),
+            bp::args = std::vector<std::string>{"--socket", socket_path_.string(), "--worker", std::to_string(index), "--log_config",
+                                                options_.log_config, "--command", options_.command, "--work_dir", options_.work_dir.string()},
+            io_context_, bp::on_exit = [this, index, generation](int exit_code, const std::error_code&) { onWorkerExit(index, generation, exit_code); });
+    } catch (const bp::process_error& e) {
+        STREAM_ERROR() << "Failed to start backend worker " << index << ": " << e.what();
+        worker.process.reset();
+
+        auto timer = std::make_shared<asio::steady_timer>(io_context_, options_.respawn_delay);
+        timer->async_wait([this, index, timer](const boost::system::error_code& ec) {
+            if (!ec && running_) {
+                spawn(index);
+            }
+        });
+    }
+}
+
+void WorkerPool::onWorkerExit(unsigned int index, unsigned int generation, int exit_code) {
+    auto& worker = workers_[index];
+    if (generation != worker.generation) {
+        return;
+    }
+
+    if (worker.connection) {
+        boost::system::error_code ec;
+        worker.connection->close(ec);
+        worker.connection.reset();
+    }
+    worker.process.reset();
+
+    if (!running_) {
+        if (auto id = std::exchange(worker.task, std::nullopt)) {
+            task_manager_.updateTaskStatus(*id, TaskManager::kQueued);
+        }
+        bool all_exited = std::none_of(workers_.begin(), workers_.end(), [](const Worker& w) { return w.process != nullptr; });
+        if (all_exited) {
+            shutdown_timer_.cancel();
+        }
+        return;
+    }
+
+    STREAM_WARN() << "Backend worker " << index << " exited with code " << exit_code << ", respawning.";
+
+    if (auto id = std::exchange(worker.task, std::nullopt)) {
+        if (++attempts_[*id] >= options_.max_attempts) {
+            STREAM_ERROR() << "Task " << *id << " took down " << attempts_[*id] << " workers, giving up.";
+            task_manager_.failTask(*id, "Backend worker crashed while running the task");
+            attempts_.erase(*id);
+        } else {
+            // Back at its original due time: the task was already waiting its turn once.
+            task_manager_.updateTaskStatus(*id, TaskManager::kQueued);
+            pending_.insert({worker.task_due, next_sequence_++, *id});
+        }
+    }
+
+    auto timer = std::make_shared<asio::steady_timer>(io_context_, options_.respawn_delay);
+    timer->async_wait([this, index, timer](const boost::system::error_code& ec) {
+        if (!ec && running_) {
+            spawn(index);
+        }
+    });
+
+    dispatch();
+}
+
+asio::awaitable<void> WorkerPool::acceptWorkers() {
+    while (running_) {
+        boost::system::error_code ec;
+        auto socket = std::make_shared<Socket>(co_await acceptor_.async_accept(asio::redirect_error(asio::use_awaitable, ec)));
+        if (ec) {
+            if (ec == asio::error::operation_aborted) {
+                break;
+            }
+            STREAM_WARN() << "Accepting a backend worker failed: " << ec.message();
+            continue;
+        }
+        asio::co_spawn(io_context_, workerSession(std::move(socket)), asio::detached);
+    }
+}
+
+asio::awaitable<void> WorkerPool::workerSession(std::shared_ptr<Socket> socket) {
+    std::string buffer;
+    std::optional<unsigned int> index;
+
+    try {
+        while (true) {
+            auto length = co_await asio::async_read_until(*socket, asio::dynamic_buffer(buffer), '\n', asio::use_awaitable);
+            std::string line = buffer.substr(0, length - 1);
+            buffer.erase(0, length);
+
+            if (index) {
+                onMessage(*index, line);
+                continue;
+            }
+
+            // The first line has to identify a worker this pool spawned.
+            auto hello = nlohmann::json::parse(line);
+            auto i     = hello.at("worker").get<unsigned int>();
+            auto pid   = hello.at("pid").get<int>();
+            if (hello.at("type") != protocol::kHello || i >= workers_.size() || !workers_[i].process || workers_[i].process->id() != pid) {
+                STREAM_WARN() << "Rejected unexpected backend connection: " << line;
+                co_return;
+            }
+
+            index                  = i;
+            workers_[i].connection = socket;
+            STREAM_INFO() << "Backend worker " << i << " (pid " << pid << ") connected.";
+            dispatch();
+        }
+    } catch (const std::exception& e) {
+        if (running_ && index) {
+            STREAM_WARN() << "Lost connection to backend worker " << *index << ": " << e.what();
+        }
+    }
+
+    // A worker without its connection is useless; make sure it exits so the exit handler requeues its task.
+    if (index && workers_[*index].connection == socket && workers_[*index].process) {
+        workers_[*index].connection.reset();
+        ::kill(workers_[*index].process->id(), SIGKILL);
+    }
+}
+
+void WorkerPool::onMessage(unsigned int index, const std::string& line) {
+    auto& worker = workers_[index];
+
+    nlohmann::json message = nlohmann::json::parse(line, nullptr, false);
+    if (message.is_discarded() || !message.contains("type") || !message.contains("id")) {
+        STREAM_WARN() << "Malformed message from backend worker " << index << ": " << line;
+        return;
+    }
+
+    auto id = message["id"].get<std::string>();
+    if (worker.task != id) {
+        STREAM_WARN() << "Backend worker " << index << " reported on task " << id << " it is not running.";
+        return;
+    }
+
+    if (message.contains("resources") && message["resources"].is_object()) {
+        task_manager_.updateTaskResources(id, protocol::DecodeResources(message["resources"]));
+    }
+
+    const auto type = message["type"].get<std::string>();
+    if (type == protocol::kProgress) {
+        task_manager_.updateTaskProgress(id, message.value("progress", 0.0));
+        return;
+    }
+
+    if (type == protocol::kDone) {
+        task_manager_.updateTaskStatus(id, TaskManager::kCompleted);
+    } else if (type == protocol::kFailed) {
+        task_manager_.failTask(id, message.value("error", std::string("Unknown error")));
+    } else {
+        STREAM_WARN() << "Unknown message type from backend worker " << index << ": " << type;
+        return;
+    }
+
+    attempts_.erase(id);
+    worker.task.reset();
+    dispatch();
+}
+
+void WorkerPool::dispatch() {
+    for (auto& worker : workers_) {
+        while (worker.idle() && !pending_.empty()) {
+            auto next = pending_.extract(pending_.begin());
+            auto id   = std::move(next.value().id);
+
+            auto task = task_manager_.getTask(id);
+            if (!task || task->status != TaskManager::kQueued) {
+                continue;
+            }
+
+            worker.task     = id;
+            worker.task_due = next.value().due;
+            task_manager_.updateTaskStatus(id, TaskManager::kRunning);
+            send(worker, protocol::EncodeMessage(
+                             {{"type", protocol::kTask}, {"id", id}, {"input_files", *task->input_files}, {"output_file", task->output_file}}));
+        }
+    }
+}
+
+void WorkerPool::send(Worker& worker, std::string message) {
+    auto buffer = std::make_shared<std::string>(std::move(message));
+    // Write errors surface as a read error in the worker session, which handles the cleanup.
+    asio::async_write(*worker.connection, asio::buffer(*buffer), [buffer, connection = worker.connection](const boost::system::error_code&, std::size_t) {});
+}
+
+}  // namespace eurora::fe
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <boost/process.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "task_manager.h"
+
+namespace eurora::fe {
+
+/**
+ * Spawns and supervises the backend worker processes and feeds them queued tasks.
+ *
+ * Workers connect back over a local stream socket (see apps/common/worker_protocol.h) and run one task at a time,
+ * so a crashing reconstruction only takes its own process down. Queued tasks are handed out earliest due first
+ * (see core::DueTime()), so interactive scans overtake batch reprocessing while aging keeps batch work from starving.
+ * When a worker exits, its in-flight task is queued again at its original due time for the remaining workers and
+ * the slot is respawned after a short delay; a task that has taken down `max_attempts` workers is failed instead of
+ * being retried forever.
+ *
+ * All pool state is owned by one internal thread; the public methods only post to it.
+ */
+class WorkerPool {
+public:
+    struct Options {
+        std::filesystem::path executable;
+        unsigned int num_workers = 1;
+        std::string log_config;
+        std::string command;             ///< Reconstruction command template forwarded to the workers.
+        std::filesystem::path work_dir;  ///< Directory the workers confine task files to.
+        std::chrono::milliseconds respawn_delay{1000};
+        unsigned int max_attempts = 3;
+    };
+
+    WorkerPool(Options options, TaskManager& task_manager);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&)            = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void start();
+    /// Asks idle workers to exit, kills the busy ones and joins the supervisor thread.
+    void stop();
+
+    /// Queues a task for the next idle worker, ordered by its priority. Thread-safe.
+    void submit(const std::string& id, core::TaskPriority priority = core::TaskPriority::kNormal);
+
+private:
+    using Socket = boost::asio::local::stream_protocol::socket;
+
+    struct Worker {
+        unsigned int generation = 0;
+        std::unique_ptr<boost::process::child> process;
+        std::shared_ptr<Socket> connection;
+        std::optional<std::string> task;
+        std::chrono::steady_clock::time_point task_due;
+
+        bool idle() const { return connection && !task; }
+    };
+
+    struct Pending {
+        std::chrono::steady_clock::time_point due;
+        uint64_t sequence;
+        std::string id;
+
+        bool operator<(const Pending& other) const { return std::tie(due, sequence) < std::tie(other.due, other.sequence); }
+    };
+
+    boost::asio::awaitable<void> acceptWorkers();
+    boost::asio::awaitable<void> workerSession(std::shared_ptr<Socket> socket);
+
+    void spawn(unsigned int index);
+    void onWorkerExit(unsigned int index, unsigned int generation, int exit_code);
+    void onMessage(unsigned int index, const std::string& line);
+    void dispatch();
+    void send(Worker& worker, std::string message);
+
+private:
+    Options options_;
+    TaskManager& task_manager_;
+    std::filesystem::path socket_path_;
+    bool running_ = false;
+
+    boost::asio::io_context io_context_;
+    boost::asio::local::stream_protocol::acceptor acceptor_;
+    boost::asio::steady_timer shutdown_timer_;
+    std::thread thread_;
+
+    std::vector<Worker> workers_;
+    std::set<Pending> pending_;
+    uint64_t next_sequence_ = 0;
+    std::unordered_map<std::string, unsigned int> attempts_;
+};
+}  // namespace eurora::fe
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "io/compression.hpp"
+#include "storage_client.h"
+#include "thread_pool.hpp"
+
+namespace eurora::core {
+
+/**
+ * Compresses payloads on their way into another StorageClient and decompresses them on the way out.
+ *
+ * Stored items get a "codec" custom tag naming the codec, so listings show how an item was written; the payload
+ * itself also starts with a small header, which is what reads rely on. Items without that header, e.g. stored
+ * before compression was enabled, read back unchanged.
+ */
+class CompressedStorageClient : public StorageClient {
+public:
+    static constexpr const char* kCodecTag = "codec";
+
+    CompressedStorageClient(std::shared_ptr<StorageClient> inner, io::CompressionOptions options = io::CompressionOptions::Fast(),
+                            unsigned int num_threads = std::max(1u, std::thread::hardware_concurrency()))
+        : StorageClient("compressed://"),
+          inner_(std::move(inner)),
+          options_(options),
+          num_threads_(num_threads),
+          pool_(num_threads > 1 ? std::make_unique<ThreadPool>(num_threads, "compression") : nullptr) {}
+
+    StorageItemList list_items(const StorageItemTags& tags, size_t limit = 20) override { return inner_->list_items(tags, limit); }
+    StorageItemList get_next_page_of_items(const StorageItemList& page) override { return inner_->get_next_page_of_items(page); }
+
+    std::shared_ptr<std::istream> get_latest_item(const StorageItemTags& tags) override { return decompress(inner_->get_latest_item(tags)); }
+    std::shared_ptr<std::istream> get_item_by_url(std::string_view url) override { return decompress(inner_->get_item_by_url(url)); }
+
+    StorageItem store_item(const StorageItemTags& tags, std::istream& data, std::optional<std::chrono::seconds> ttl = {}) override {
+        return store_item_streamed(
+            tags,
+            [&data](std::ostream& sink) {
+                std::vector<char> buffer(io::kChunkSize);
+                while (data) {
+                    data.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                    sink.write(buffer.data(), data.gcount());
+                }
+            },
+            ttl);
+    }
+
+    StorageItem store_item_streamed(const StorageItemTags& tags, const StorageWriteFunction& write, std::optional<std::chrono::seconds> ttl = {}) override {
+        auto tagged = tags;
+        tagged.custom_tags.emplace(kCodecTag, std::string(io::CodecName(options_.codec)));
+
+        return inner_->store_item_streamed(
+            tagged,
+            [this, &write](std::ostream& sink) {
+                // Two blocks per thread keeps the pool busy while bounding what is buffered.
+                io::CompressingStreamBuf buffer(sink, options_, pool_.get(), 2 * num_threads_);
+                std::ostream stream(&buffer);
+                stream.exceptions(std::ios::badbit);
+                write(stream);
+                stream.flush();
+                buffer.finish();
+            },
+            ttl);
+    }
+
+    std::optional<std::string> health_check() override { return inner_->health_check(); }
+
+    const io::CompressionOptions& options() const { return options_; }
+
+private:
+    static std::shared_ptr<std::istream> decompress(std::shared_ptr<std::istream> stream) {
+        if (!stream) {
+            return nullptr;
+        }
+        return std::make_shared<io::DecompressingStream>(std::move(stream));
+    }
+
+private:
+    std::shared_ptr<StorageClient> inner_;
+    const io::CompressionOptions options_;
+    const unsigned int num_threads_;
+    std::unique_ptr<ThreadPool> pool_;
+};
+
+}  // namespace eurora::core
@@ -4,9 +4,9 @@
 
 namespace eurora::core {
 
-sdt::filesystem::path DefaultWorkingFolder();
-sdt::filesystem::path DefaultEuroraHome();
-sdt::filesystem::path DefaultDatabaseFolder();
-sdt::filesystem::path DefaultStorageFolder();
+std::filesystem::path DefaultWorkingFolder();
+std::filesystem::path DefaultEuroraHome();
+std::filesystem::path DefaultDatabaseFolder();
+std::filesystem::path DefaultStorageFolder();
 
 }  // namespace eurora::core
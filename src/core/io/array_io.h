@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+#include "core/types.h"
+#include "primitives.h"
+
+namespace eurora::core::io {
+
+/**
+ * NdArray layout: uint32 rows, uint32 cols, then the elements row-major. Elements go straight between the array's
+ * own buffer and the stream in kChunkSize pieces, so no intermediate copy of the payload is ever built.
+ */
+template <class T>
+struct Serializer<nc::NdArray<T>> {
+    static void write(std::ostream& stream, const nc::NdArray<T>& array) {
+        const auto shape = array.shape();
+        io::write(stream, static_cast<uint32_t>(shape.rows));
+        io::write(stream, static_cast<uint32_t>(shape.cols));
+        io::write(stream, array.data(), array.size());
+    }
+
+    static nc::NdArray<T> read(std::istream& stream) {
+        auto rows = io::read<uint32_t>(stream);
+        auto cols = io::read<uint32_t>(stream);
+        nc::NdArray<T> array(rows, cols);
+        io::read(stream, array.data(), array.size());
+        return array;
+    }
+};
+
+/// Image layout: ImageHeader, the optional serialized MetaContainer, then the pixel array.
+template <class T>
+struct Serializer<Image<T>> {
+    static void write(std::ostream& stream, const Image<T>& image) {
+        io::write(stream, image.header);
+        // Metadata is a few hundred bytes of XML; building it in memory is fine.
+        std::optional<std::string> meta;
+        if (image.metadata) {
+            std::stringstream meta_stream;
+            ISMRMRD::serialize(*image.metadata, meta_stream);
+            meta = meta_stream.str();
+        }
+        io::write(stream, meta);
+        io::write(stream, image.image_data);
+    }
+
+    static Image<T> read(std::istream& stream) {
+        auto header = io::read<ISMRMRD::ImageHeader>(stream);
+        std::optional<ISMRMRD::MetaContainer> metadata;
+        if (auto meta = io::read<std::optional<std::string>>(stream)) {
+            metadata.emplace();
+            ISMRMRD::deserialize(meta->c_str(), *metadata);
+        }
+        return Image<T>(header, io::read<nc::NdArray<T>>(stream), std::move(metadata));
+    }
+};
+
+/**
+ * Reads a serialized NdArray into `array`, reusing its buffer. The stored shape has to match the array's, so a
+ * caller that reads the same map repeatedly allocates once.
+ */
+template <class T>
+void read_into(std::istream& stream, nc::NdArray<T>& array) {
+    auto rows        = io::read<uint32_t>(stream);
+    auto cols        = io::read<uint32_t>(stream);
+    const auto shape = array.shape();
+    if (rows != shape.rows || cols != shape.cols) {
+        EURORA_THROW_ERROR(eurora::utils::ErrorCode::kData_DimensionMismatch,
+                           "Stored array is " + std::to_string(rows) + "x" + std::to_string(cols) + ", buffer is " + std::to_string(shape.rows) +
+                               "x" + std::to_string(shape.cols));
+    }
+    io::read(stream, array.data(), array.size());
+}
+
+}  // namespace eurora::core::io
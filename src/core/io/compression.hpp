@@ -0,0 +1,378 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <lz4.h>
+#include <zstd.h>
+
+#include "core/thread_pool.hpp"
+#include "eurora/utils/exception.hpp"
+#include "eurora/utils/trace.h"
+#include "primitives.h"
+
+namespace eurora::core::io {
+
+enum class Codec : uint8_t {
+    kNone = 0,
+    kLz4  = 1,
+    kZstd = 2,
+};
+
+inline std::string_view CodecName(Codec codec) {
+    switch (codec) {
+        case Codec::kNone:
+            return "none";
+        case Codec::kLz4:
+            return "lz4";
+        case Codec::kZstd:
+            return "zstd";
+    }
+    return "unknown";
+}
+
+/**
+ * Blosc-style compression: the payload is cut into blocks, each block is byte-shuffled by `type_size` (grouping the
+ * exponent bytes of neighbouring floats together) and then compressed on its own. Blocks are independent, so a
+ * batch of them is compressed in parallel.
+ *
+ * LZ4 is the fast path for the reconstruction pipeline; Zstd trades speed for ratio when archiving raw data.
+ */
+struct CompressionOptions {
+    Codec codec         = Codec::kLz4;
+    int level           = 0;  ///< Zstd level; 0 picks Zstd's default. LZ4 ignores it.
+    uint8_t type_size   = 4;  ///< Element size to shuffle by: 4 for float and complex<float>, 8 for double.
+    uint32_t block_size = static_cast<uint32_t>(kChunkSize);
+
+    static CompressionOptions Fast() { return {}; }
+    static CompressionOptions Archive() { return {.codec = Codec::kZstd, .level = 9}; }
+};
+
+/**
+ * Stream layout: a 12 byte header ("EURZ", version, codec, type size, reserved, uint32 block size), then blocks of
+ * uint32 raw size, uint32 stored size and the stored bytes, terminated by a zero raw size. A stored size with
+ * kRawBlock set holds the block uncompressed because compressing it did not pay off.
+ */
+namespace compression {
+
+inline constexpr std::array<char, 4> kMagic = {'E', 'U', 'R', 'Z'};
+inline constexpr uint8_t kVersion           = 1;
+inline constexpr std::size_t kHeaderSize    = 12;
+inline constexpr uint32_t kRawBlock         = 0x80000000u;
+
+inline void Shuffle(const char* in, char* out, std::size_t size, std::size_t type_size) {
+    const std::size_t elements = size / type_size;
+    for (std::size_t i = 0; i < elements; ++i) {
+        for (std::size_t j = 0; j < type_size; ++j) {
+            out[j * elements + i] = in[i * type_size + j];
+        }
+    }
+    std::memcpy(out + elements * type_size, in + elements * type_size, size - elements * type_size);
+}
+
+inline void Unshuffle(const char* in, char* out, std::size_t size, std::size_t type_size) {
+    const std::size_t elements = size / type_size;
+    for (std::size_t i = 0; i < elements; ++i) {
+        for (std::size_t j = 0; j < type_size; ++j) {
+            out[i * type_size + j] = in[j * elements + i];
+        }
+    }
+    std::memcpy(out + elements * type_size, in + elements * type_size, size - elements * type_size);
+}
+
+struct Block {
+    uint32_t raw_size    = 0;
+    uint32_t stored_size = 0;  // Including the kRawBlock flag.
+    std::vector<char> data;
+};
+
+inline Block CompressBlock(std::vector<char> raw, const CompressionOptions& options) {
+    eurora::utils::TraceSpan span("io", "compression::CompressBlock");
+    span.SetArg("bytes", static_cast<std::int64_t>(raw.size()));
+    Block block;
+    block.raw_size = static_cast<uint32_t>(raw.size());
+
+    std::vector<char> shuffled(raw.size());
+    Shuffle(raw.data(), shuffled.data(), raw.size(), options.type_size);
+
+    std::size_t compressed = 0;
+    if (options.codec == Codec::kLz4) {
+        block.data.resize(static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(raw.size()))));
+        compressed = static_cast<std::size_t>(
+            LZ4_compress_default(shuffled.data(), block.data.data(), static_cast<int>(raw.size()), static_cast<int>(block.data.size())));
+    } else if (options.codec == Codec::kZstd) {
+        block.data.resize(ZSTD_compressBound(raw.size()));
+        auto result = ZSTD_compress(block.data.data(), block.data.size(), shuffled.data(), raw.size(), options.level);
+        compressed  = ZSTD_isError(result) ? 0 : result;
+    }
+
+    if (compressed == 0 || compressed >= raw.size()) {
+        block.data        = std::move(raw);
+        block.stored_size = block.raw_size | kRawBlock;
+        return block;
+    }
+    block.data.resize(compressed);
+    block.stored_size = static_cast<uint32_t>(compressed);
+    return block;
+}
+
+inline void DecompressBlock(Codec codec, std::size_t type_size, const std::vector<char>& stored, std::vector<char>& shuffled, char* out,
+                            std::size_t raw_size) {
+    eurora::utils::TraceSpan span("io", "compression::DecompressBlock");
+    span.SetArg("bytes", static_cast<std::int64_t>(raw_size));
+    shuffled.resize(raw_size);
+    std::size_t produced = 0;
+    if (codec == Codec::kLz4) {
+        int result = LZ4_decompress_safe(stored.data(), shuffled.data(), static_cast<int>(stored.size()), static_cast<int>(raw_size));
+        produced   = result < 0 ? 0 : static_cast<std::size_t>(result);
+    } else if (codec == Codec::kZstd) {
+        auto result = ZSTD_decompress(shuffled.data(), raw_size, stored.data(), stored.size());
+        produced    = ZSTD_isError(result) ? 0 : result;
+    }
+    if (produced != raw_size) {
+        EURORA_THROW_ERROR(eurora::utils::ErrorCode::kData_UnsupportedFormat, "Corrupt " + std::string(CodecName(codec)) + " block");
+    }
+    Unshuffle(shuffled.data(), out, raw_size, type_size);
+}
+
+}  // namespace compression
+
+/**
+ * Output side: collects the written bytes into blocks and compresses `batch` of them at a time on `pool` (inline
+ * when null), writing the results to `sink` in order. Memory held is about two blocks per batch entry. finish() has
+ * to be called once everything is written.
+ */
+class CompressingStreamBuf : public std::streambuf {
+public:
+    CompressingStreamBuf(std::ostream& sink, CompressionOptions options, ThreadPool* pool = nullptr, std::size_t batch = 1)
+        : sink_(sink), options_(options), pool_(pool), batch_(pool ? std::max<std::size_t>(batch, 1) : 1) {
+        if (options_.type_size == 0 || options_.block_size == 0 || options_.block_size >= compression::kRawBlock) {
+            EURORA_THROW_ERROR(eurora::utils::ErrorCode::kInvalidArgument, "Invalid compression block or type size");
+        }
+        sink_.write(compression::kMagic.data(), compression::kMagic.size());
+        io::write(sink_, compression::kVersion);
+        io::write(sink_, static_cast<uint8_t>(options_.codec));
+        io::write(sink_, options_.type_size);
+        io::write(sink_, uint8_t(0));
+        io::write(sink_, options_.block_size);
+        start_block();
+    }
+
+    CompressingStreamBuf(const CompressingStreamBuf&)            = delete;
+    CompressingStreamBuf& operator=(const CompressingStreamBuf&) = delete;
+
+    void finish() {
+        seal_block();
+        flush_batch();
+        io::write(sink_, uint32_t(0));
+    }
+
+protected:
+    int_type overflow(int_type ch) override {
+        seal_block();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize count) override {
+        std::streamsize written = 0;
+        while (written < count) {
+            if (pptr() == epptr()) {
+                seal_block();
+            }
+            auto chunk = std::min<std::streamsize>(count - written, epptr() - pptr());
+            std::memcpy(pptr(), data + written, static_cast<std::size_t>(chunk));
+            pbump(static_cast<int>(chunk));
+            written += chunk;
+        }
+        return count;
+    }
+
+private:
+    void start_block() {
+        block_.resize(options_.block_size);
+        setp(block_.data(), block_.data() + block_.size());
+    }
+
+    void seal_block() {
+        auto used = static_cast<std::size_t>(pptr() - pbase());
+        if (used == 0) {
+            return;
+        }
+        block_.resize(used);
+        pending_.push_back(std::move(block_));
+        block_ = {};
+        if (pending_.size() >= batch_) {
+            flush_batch();
+        }
+        start_block();
+    }
+
+    void flush_batch() {
+        std::vector<compression::Block> blocks;
+        if (pool_) {
+            std::vector<std::future<compression::Block>> futures;
+            for (auto& raw : pending_) {
+                auto task = [options = options_, raw = std::move(raw)]() mutable { return compression::CompressBlock(std::move(raw), options); };
+                futures.push_back(pool_->Push(std::move(task)));
+            }
+            for (auto& future : futures) {
+                blocks.push_back(future.get());
+            }
+        } else {
+            for (auto& raw : pending_) {
+                blocks.push_back(compression::CompressBlock(std::move(raw), options_));
+            }
+        }
+        pending_.clear();
+
+        for (const auto& block : blocks) {
+            io::write(sink_, block.raw_size);
+            io::write(sink_, block.stored_size);
+            io::write(sink_, block.data.data(), block.data.size());
+        }
+    }
+
+private:
+    std::ostream& sink_;
+    const CompressionOptions options_;
+    ThreadPool* pool_;
+    const std::size_t batch_;
+
+    std::vector<char> block_;
+    std::vector<std::vector<char>> pending_;
+};
+
+/**
+ * Input side: decodes a stream written by CompressingStreamBuf one block at a time. A source that does not start
+ * with the stream header is passed through unchanged, so items stored before compression was enabled still read.
+ */
+class DecompressingStreamBuf : public std::streambuf {
+public:
+    explicit DecompressingStreamBuf(std::streambuf& source) : source_(source) {
+        std::array<char, compression::kHeaderSize> header{};
+        auto count = static_cast<std::size_t>(source_.sgetn(header.data(), header.size()));
+
+        if (count < header.size() || !std::equal(compression::kMagic.begin(), compression::kMagic.end(), header.begin())) {
+            passthrough_ = true;
+            raw_.assign(header.begin(), header.begin() + count);
+            setg(raw_.data(), raw_.data(), raw_.data() + raw_.size());
+            return;
+        }
+
+        if (static_cast<uint8_t>(header[4]) != compression::kVersion) {
+            EURORA_THROW_ERROR(eurora::utils::ErrorCode::kData_UnsupportedFormat, "Unknown compressed stream version");
+        }
+        codec_     = static_cast<Codec>(header[5]);
+        type_size_ = static_cast<uint8_t>(header[6]);
+        std::memcpy(&block_size_, header.data() + 8, sizeof(block_size_));
+        if (codec_ != Codec::kNone && codec_ != Codec::kLz4 && codec_ != Codec::kZstd) {
+            EURORA_THROW_ERROR(eurora::utils::ErrorCode::kData_UnsupportedFormat, "Unknown compression codec");
+        }
+        // Both are divisors when unshuffling; a foreign or corrupt header must not reach that.
+        if (type_size_ == 0 || block_size_ == 0) {
+            EURORA_THROW_ERROR(eurora::utils::ErrorCode::kData_UnsupportedFormat, "Corrupt compressed stream header");
+        }
+        setg(nullptr, nullptr, nullptr);
+    }
+
+    std::optional<Codec> codec() const { return passthrough_ ? std::nullopt : std::optional<Codec>(codec_); }
+
+protected:
+    int_type underflow() override {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        return (passthrough_ ? read_raw() : read_block()) ? traits_type::to_int_type(*gptr()) : traits_type::eof();
+    }
+
+private:
+    bool read_raw() {
+        raw_.resize(kChunkSize);
+        auto count = source_.sgetn(raw_.data(), static_cast<std::streamsize>(raw_.size()));
+        setg(raw_.data(), raw_.data(), raw_.data() + count);
+        return count > 0;
+    }
+
+    bool read_block() {
+        uint32_t sizes[2];
+        if (finished_ || source_.sgetn(reinterpret_cast<char*>(sizes), sizeof(sizes[0])) != sizeof(sizes[0])) {
+            return false;
+        }
+        if (sizes[0] == 0) {
+            finished_ = true;
+            return false;
+        }
+        if (source_.sgetn(reinterpret_cast<char*>(&sizes[1]), sizeof(sizes[1])) != sizeof(sizes[1])) {
+            EURORA_THROW_ERROR(eurora::utils::ErrorCode::kIO_ReadError, "Truncated compressed stream");
+        }
+
+        const uint32_t raw_size = sizes[0];
+        const bool stored_raw   = (sizes[1] & compression::kRawBlock) != 0;
+        const uint32_t stored   = sizes[1] & ~compression::kRawBlock;
+        // Compressed blocks are only kept when smaller than the raw bytes.
+        if (raw_size > block_size_ || (stored_raw ? stored != raw_size : stored >= raw_size)) {
+            EURORA_THROW_ERROR(eurora::utils::ErrorCode::kData_UnsupportedFormat, "Corrupt compressed block header");
+        }
+
+        raw_.resize(raw_size);
+        if (stored_raw) {
+            read_exact(raw_.data(), raw_size);
+        } else {
+            stored_.resize(stored);
+            read_exact(stored_.data(), stored);
+            compression::DecompressBlock(codec_, type_size_, stored_, shuffled_, raw_.data(), raw_size);
+        }
+        setg(raw_.data(), raw_.data(), raw_.data() + raw_size);
+        return true;
+    }
+
+    void read_exact(char* data, std::size_t size) {
+        if (static_cast<std::size_t>(source_.sgetn(data, static_cast<std::streamsize>(size))) != size) {
+            EURORA_THROW_ERROR(eurora::utils::ErrorCode::kIO_ReadError, "Truncated compressed stream");
+        }
+    }
+
+private:
+    std::streambuf& source_;
+    bool passthrough_    = false;
+    bool finished_       = false;
+    Codec codec_         = Codec::kNone;
+    uint8_t type_size_   = 1;
+    uint32_t block_size_ = 0;
+
+    std::vector<char> raw_;
+    std::vector<char> stored_;
+    std::vector<char> shuffled_;
+};
+
+/// Owns the stream it decodes, so it can be handed out in place of the source.
+class DecompressingStream : public std::istream {
+public:
+    explicit DecompressingStream(std::shared_ptr<std::istream> source) : std::istream(nullptr), source_(std::move(source)), buffer_(*source_->rdbuf()) {
+        rdbuf(&buffer_);
+        exceptions(std::ios::badbit);  // Corrupt data surfaces as the codec's error instead of a silent short read.
+    }
+
+    std::optional<Codec> codec() const { return buffer_.codec(); }
+
+private:
+    std::shared_ptr<std::istream> source_;
+    DecompressingStreamBuf buffer_;
+};
+
+}  // namespace eurora::core::io
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <istream>
+#include <streambuf>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "eurora/utils/exception.hpp"
+
+namespace eurora::core::io {
+
+/**
+ * Read-only stream buffer over a memory mapped file. The get area is the mapping itself, so reading never copies
+ * the file into a heap buffer and pages are faulted in on demand. The mapping stays valid after the file is
+ * unlinked.
+ */
+class MappedStreamBuf : public std::streambuf {
+public:
+    explicit MappedStreamBuf(const std::filesystem::path& path);
+    ~MappedStreamBuf() override;
+
+    MappedStreamBuf(const MappedStreamBuf&)            = delete;
+    MappedStreamBuf& operator=(const MappedStreamBuf&) = delete;
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+protected:
+    pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+    pos_type seekpos(pos_type position, std::ios_base::openmode which) override;
+    std::streamsize showmanyc() override { return egptr() - gptr(); }
+
+private:
+    char* data_       = nullptr;
+    std::size_t size_ = 0;
+};
+
+class MappedFileStream : public std::istream {
+public:
+    explicit MappedFileStream(const std::filesystem::path& path) : std::istream(nullptr), buffer_(path) { rdbuf(&buffer_); }
+
+    std::size_t size() const { return buffer_.size(); }
+
+private:
+    MappedStreamBuf buffer_;
+};
+
+/** Implementation **/
+
+inline MappedStreamBuf::MappedStreamBuf(const std::filesystem::path& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        EURORA_THROW_ERROR(eurora::utils::ErrorCode::kIO_FileOpenFailed, path.string() + ": " + std::strerror(errno));
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        EURORA_THROW_ERROR(eurora::utils::ErrorCode::kIO_ReadError, path.string() + ": " + std::strerror(errno));
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+
+    // mmap rejects empty lengths; an empty file is an empty get area.
+    if (size_ > 0) {
+        void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            EURORA_THROW_ERROR(eurora::utils::ErrorCode::kIO_ReadError, "mmap " + path.string() + ": " + std::strerror(errno));
+        }
+        ::madvise(mapping, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<char*>(mapping);
+    }
+    ::close(fd);
+
+    setg(data_, data_, data_ + size_);
+}
+
+inline MappedStreamBuf::~MappedStreamBuf() {
+    if (data_) {
+        ::munmap(data_, size_);
+    }
+}
+
+inline MappedStreamBuf::pos_type MappedStreamBuf::seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode which) {
+    if (!(which & std::ios_base::in)) {
+        return pos_type(off_type(-1));
+    }
+
+    off_type base = 0;
+    if (dir == std::ios_base::cur) {
+        base = gptr() - eback();
+    } else if (dir == std::ios_base::end) {
+        base = static_cast<off_type>(size_);
+    }
+    return seekpos(pos_type(base + offset), which);
+}
+
+inline MappedStreamBuf::pos_type MappedStreamBuf::seekpos(pos_type position, std::ios_base::openmode which) {
+    const off_type target = off_type(position);
+    if (!(which & std::ios_base::in) || target < 0 || target > static_cast<off_type>(size_)) {
+        return pos_type(off_type(-1));
+    }
+    setg(eback(), eback() + target, egptr());
+    return position;
+}
+
+}  // namespace eurora::core::io
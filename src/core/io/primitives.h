@@ -0,0 +1,178 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "eurora/utils/exception.hpp"
+#include "eurora/utils/metrics.h"
+#include "eurora/utils/resource_usage.h"
+#include "eurora/utils/trace.h"
+
+namespace eurora::core::io {
+
+/// Large payloads are moved in pieces of at most this many bytes, so a sink never sees one multi-GB write.
+inline constexpr std::size_t kChunkSize = std::size_t(1) << 20;
+
+/// Bulk reads and writes at least this large show up as spans in traces; smaller ones, e.g. headers, would be noise.
+inline constexpr std::size_t kTracedSize = std::size_t(64) << 10;
+
+namespace detail {
+
+inline eurora::utils::Counter& BytesMoved(const char* direction) {
+    return eurora::utils::MetricsRegistry::Instance().GetCounter("eurora_io_bytes_total", "Bytes moved by bulk io::read and io::write calls.",
+                                                                 {{"direction", direction}});
+}
+
+}  // namespace detail
+
+/**
+ * Binary serialization of a type to and from a stream. Specialize it to make a type storable; read() and write()
+ * below dispatch here, so specializations may be declared after code that uses them.
+ */
+template <class T>
+struct Serializer;
+
+template <class T>
+void write(std::ostream& stream, const T& value) {
+    Serializer<T>::write(stream, value);
+}
+
+template <class T>
+T read(std::istream& stream) {
+    return Serializer<T>::read(stream);
+}
+
+template <class T>
+    requires std::is_trivially_copyable_v<T>
+void write(std::ostream& stream, const T* data, std::size_t count) {
+    auto bytes = reinterpret_cast<const char*>(data);
+    auto left  = count * sizeof(T);
+
+    static auto& bytes_out = detail::BytesMoved("out");
+    bytes_out.Increment(left);
+    eurora::utils::ResourceAccount::CountWritten(left);
+
+    eurora::utils::TraceSpan span("io", "io::write", left >= kTracedSize);
+    span.SetArg("bytes", static_cast<std::int64_t>(left));
+    while (left > 0) {
+        auto chunk = std::min(left, kChunkSize);
+        if (!stream.write(bytes, static_cast<std::streamsize>(chunk))) {
+            EURORA_THROW_ERROR(eurora::utils::ErrorCode::kIO_WriteError, "Failed to write to the output stream");
+        }
+        bytes += chunk;
+        left -= chunk;
+    }
+}
+
+/// Fills `count` elements at `data`, which the caller has already sized.
+template <class T>
+    requires std::is_trivially_copyable_v<T>
+void read(std::istream& stream, T* data, std::size_t count) {
+    auto bytes = reinterpret_cast<char*>(data);
+    auto left  = count * sizeof(T);
+
+    static auto& bytes_in = detail::BytesMoved("in");
+    bytes_in.Increment(left);
+    eurora::utils::ResourceAccount::CountRead(left);
+
+    eurora::utils::TraceSpan span("io", "io::read", left >= kTracedSize);
+    span.SetArg("bytes", static_cast<std::int64_t>(left));
+    while (left > 0) {
+        auto chunk = std::min(left, kChunkSize);
+        if (!stream.read(bytes, static_cast<std::streamsize>(chunk))) {
+            EURORA_THROW_ERROR(eurora::utils::ErrorCode::kIO_ReadError, "Unexpected end of the input stream");
+        }
+        bytes += chunk;
+        left -= chunk;
+    }
+}
+
+inline void write_string_to_stream(std::ostream& stream, const std::string& value) {
+    const uint64_t length = value.size();
+    write(stream, length);
+    write(stream, value.data(), value.size());
+}
+
+inline std::string read_string_from_stream(std::istream& stream) {
+    std::string value(read<uint64_t>(stream), '\0');
+    read(stream, value.data(), value.size());
+    return value;
+}
+
+/** Serializers **/
+
+template <class T>
+    requires std::is_trivially_copyable_v<T>
+struct Serializer<T> {
+    static void write(std::ostream& stream, const T& value) { io::write(stream, &value, 1); }
+
+    static T read(std::istream& stream) {
+        T value;
+        io::read(stream, &value, 1);
+        return value;
+    }
+};
+
+template <>
+struct Serializer<std::string> {
+    static void write(std::ostream& stream, const std::string& value) { write_string_to_stream(stream, value); }
+    static std::string read(std::istream& stream) { return read_string_from_stream(stream); }
+};
+
+template <class T>
+struct Serializer<std::vector<T>> {
+    // std::vector<bool> is bit packed and has no data().
+    static constexpr bool kBulk = std::is_trivially_copyable_v<T> && !std::is_same_v<T, bool>;
+
+    static void write(std::ostream& stream, const std::vector<T>& values) {
+        io::write(stream, static_cast<uint64_t>(values.size()));
+        if constexpr (kBulk) {
+            io::write(stream, values.data(), values.size());
+        } else {
+            for (const auto& value : values) {
+                io::write(stream, value);
+            }
+        }
+    }
+
+    static std::vector<T> read(std::istream& stream) {
+        auto size = io::read<uint64_t>(stream);
+        std::vector<T> values;
+        if constexpr (kBulk) {
+            values.resize(size);
+            io::read(stream, values.data(), values.size());
+        } else {
+            values.reserve(size);
+            for (uint64_t i = 0; i < size; ++i) {
+                values.push_back(io::read<T>(stream));
+            }
+        }
+        return values;
+    }
+};
+
+template <class T>
+struct Serializer<std::optional<T>> {
+    static void write(std::ostream& stream, const std::optional<T>& value) {
+        io::write(stream, value.has_value());
+        if (value) {
+            io::write(stream, *value);
+        }
+    }
+
+    static std::optional<T> read(std::istream& stream) {
+        if (!io::read<bool>(stream)) {
+            return std::nullopt;
+        }
+        return io::read<T>(stream);
+    }
+};
+
+}  // namespace eurora::core::io
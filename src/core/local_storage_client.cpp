@@ -0,0 +1,487 @@
+#include "local_storage_client.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <streambuf>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+
+#include "eurora/utils/exception.hpp"
+#include "eurora/utils/logger.h"
+#include "io/mapped_stream.hpp"
+#include "sha256.hpp"
+
+namespace eurora::core {
+
+namespace fs = std::filesystem;
+using eurora::utils::ErrorCode;
+using Clock = std::chrono::system_clock;
+
+namespace {
+
+constexpr std::size_t kCopyBufferSize = 1 << 20;
+constexpr const char* kContentType    = "application/octet-stream";
+
+int64_t ToMillis(Clock::time_point time) { return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count(); }
+
+Clock::time_point FromMillis(int64_t millis) { return Clock::time_point(std::chrono::milliseconds(millis)); }
+
+nlohmann::json TagsToJson(const StorageItemTags& tags) {
+    nlohmann::json json{{"subject", tags.subject}, {"custom", nlohmann::json::array()}};
+    if (tags.device) {
+        json["device"] = *tags.device;
+    }
+    if (tags.session) {
+        json["session"] = *tags.session;
+    }
+    if (tags.name) {
+        json["name"] = *tags.name;
+    }
+    for (const auto& [key, value] : tags.custom_tags) {
+        json["custom"].push_back({key, value});
+    }
+    return json;
+}
+
+StorageItemTags TagsFromJson(const nlohmann::json& json) {
+    StorageItemTags tags;
+    tags.subject = json.at("subject").get<std::string>();
+    if (json.contains("device")) {
+        tags.device = json["device"].get<std::string>();
+    }
+    if (json.contains("session")) {
+        tags.session = json["session"].get<std::string>();
+    }
+    if (json.contains("name")) {
+        tags.name = json["name"].get<std::string>();
+    }
+    for (const auto& pair : json.at("custom")) {
+        tags.custom_tags.emplace(pair.at(0).get<std::string>(), pair.at(1).get<std::string>());
+    }
+    return tags;
+}
+
+bool Expired(const StorageItem& item, Clock::time_point now) { return item.expires && *item.expires <= now; }
+
+void ThrowErrno(ErrorCode code, const std::string& what) { EURORA_THROW_ERROR(code, what + ": " + std::strerror(errno)); }
+
+void WriteAll(int fd, const char* data, std::size_t size, const fs::path& path) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ThrowErrno(ErrorCode::kIO_WriteError, path.string());
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+// Writes `content` next to `target` and renames it over, so `target` is either absent or complete.
+void WriteFileAtomically(const fs::path& temp, const fs::path& target, const std::string& content) {
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        ThrowErrno(ErrorCode::kIO_FileOpenFailed, temp.string());
+    }
+    try {
+        WriteAll(fd, content.data(), content.size(), temp);
+        if (::fsync(fd) != 0) {
+            ThrowErrno(ErrorCode::kIO_WriteError, temp.string());
+        }
+    } catch (...) {
+        ::close(fd);
+        fs::remove(temp);
+        throw;
+    }
+    ::close(fd);
+    fs::rename(temp, target);
+}
+
+/**
+ * Output sink for a payload being staged: hashes and writes through a fixed buffer, so the memory a store needs does
+ * not depend on the payload size. The staged file is removed unless commit() is reached.
+ */
+class BlobSink : public std::streambuf {
+public:
+    BlobSink(fs::path path, Sha256& hash) : path_(std::move(path)), hash_(hash), buffer_(kCopyBufferSize) {
+        fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            ThrowErrno(ErrorCode::kIO_FileOpenFailed, path_.string());
+        }
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+    }
+
+    ~BlobSink() override {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            std::error_code ec;
+            fs::remove(path_, ec);
+        }
+    }
+
+    BlobSink(const BlobSink&)            = delete;
+    BlobSink& operator=(const BlobSink&) = delete;
+
+    /// Makes the staged file durable and returns its size.
+    std::uintmax_t commit() {
+        drain();
+        if (::fsync(fd_) != 0) {
+            ThrowErrno(ErrorCode::kIO_WriteError, path_.string());
+        }
+        ::close(fd_);
+        fd_ = -1;
+        return size_;
+    }
+
+protected:
+    int_type overflow(int_type ch) override {
+        drain();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize count) override {
+        if (count < epptr() - pptr()) {
+            std::memcpy(pptr(), data, static_cast<std::size_t>(count));
+            pbump(static_cast<int>(count));
+            return count;
+        }
+        // Large writes skip the buffer instead of being copied through it.
+        drain();
+        emit(data, static_cast<std::size_t>(count));
+        return count;
+    }
+
+    int sync() override {
+        drain();
+        return 0;
+    }
+
+private:
+    void drain() {
+        emit(pbase(), static_cast<std::size_t>(pptr() - pbase()));
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+    }
+
+    void emit(const char* data, std::size_t count) {
+        hash_.Update(data, count);
+        WriteAll(fd_, data, count, path_);
+        size_ += count;
+    }
+
+private:
+    fs::path path_;
+    Sha256& hash_;
+    std::vector<char> buffer_;
+    int fd_              = -1;
+    std::uintmax_t size_ = 0;
+};
+
+}  // namespace
+
+LocalStorageClient::LocalStorageClient(const fs::path& root, std::chrono::seconds sweep_interval)
+    : StorageClient("file://" + fs::absolute(root).string()), root_(fs::absolute(root)), sweep_interval_(sweep_interval) {
+    fs::create_directories(root_ / "blobs");
+    fs::create_directories(root_ / "items");
+    fs::create_directories(root_ / "tmp");
+
+    load();
+    sweep();
+
+    sweeper_ = std::thread([this]() { run_sweeper(); });
+}
+
+LocalStorageClient::~LocalStorageClient() {
+    {
+        std::lock_guard<std::mutex> lock(sweeper_mutex_);
+        stopping_ = true;
+    }
+    sweeper_cv_.notify_all();
+    if (sweeper_.joinable()) {
+        sweeper_.join();
+    }
+}
+
+void LocalStorageClient::load() {
+    // Staging leftovers belong to writes that never completed.
+    for (const auto& entry : fs::directory_iterator(root_ / "tmp")) {
+        std::error_code ec;
+        fs::remove(entry.path(), ec);
+    }
+
+    for (const auto& entry : fs::directory_iterator(root_ / "items")) {
+        if (entry.path().extension() != ".json") {
+            continue;
+        }
+        try {
+            std::ifstream file(entry.path());
+            auto json = nlohmann::json::parse(file);
+
+            Entry item;
+            item.item.tags         = TagsFromJson(json.at("tags"));
+            item.item.location     = location_of(entry.path().stem().string());
+            item.item.contentType  = json.value("content_type", kContentType);
+            item.item.lastModified = FromMillis(json.at("last_modified").get<int64_t>());
+            if (json.contains("expires")) {
+                item.item.expires = FromMillis(json["expires"].get<int64_t>());
+            }
+            item.blob = json.at("blob").get<std::string>();
+            item.size = json.at("size").get<std::uintmax_t>();
+
+            ++blob_refs_[item.blob];
+            items_.emplace(entry.path().stem().string(), std::move(item));
+        } catch (const std::exception& e) {
+            STREAM_WARN() << "Skipping unreadable storage record " << entry.path() << ": " << e.what();
+        }
+    }
+
+    // Blobs whose record was never written (crash between the two renames) are unreachable.
+    for (const auto& entry : fs::recursive_directory_iterator(root_ / "blobs")) {
+        if (entry.is_regular_file() && !blob_refs_.contains(entry.path().filename().string())) {
+            std::error_code ec;
+            fs::remove(entry.path(), ec);
+        }
+    }
+
+    STREAM_INFO() << "Local storage at " << root_ << " holds " << items_.size() << " items in " << blob_refs_.size() << " blobs.";
+}
+
+std::string LocalStorageClient::next_id() {
+    // Fixed width, so lexicographic order of ids is creation order.
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    char id[40];
+    std::snprintf(id, sizeof(id), "%020lld-%08x", static_cast<long long>(nanos), sequence_.fetch_add(1));
+    return id;
+}
+
+fs::path LocalStorageClient::blob_path(const std::string& hash) const { return root_ / "blobs" / hash.substr(0, 2) / hash; }
+
+fs::path LocalStorageClient::item_path(const std::string& id) const { return root_ / "items" / (id + ".json"); }
+
+fs::path LocalStorageClient::temp_path() const {
+    static std::atomic<uint64_t> counter{0};
+    return root_ / "tmp" / (std::to_string(::getpid()) + "-" + std::to_string(counter.fetch_add(1)) + ".part");
+}
+
+std::string LocalStorageClient::location_of(const std::string& id) const { return "file://" + (root_ / "items" / id).string(); }
+
+StorageItem LocalStorageClient::store_item(const StorageItemTags& tags, std::istream& data, std::optional<std::chrono::seconds> ttl) {
+    return store_item_streamed(
+        tags,
+        [&data](std::ostream& sink) {
+            std::vector<char> buffer(kCopyBufferSize);
+            while (data) {
+                data.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                sink.write(buffer.data(), data.gcount());
+            }
+            if (data.bad()) {
+                EURORA_THROW_ERROR(ErrorCode::kIO_ReadError, "Failed to read the item to store");
+            }
+        },
+        ttl);
+}
+
+StorageItem LocalStorageClient::store_item_streamed(const StorageItemTags& tags, const StorageWriteFunction& write, std::optional<std::chrono::seconds> ttl) {
+    const auto temp = temp_path();
+
+    // The payload goes to disk as it is produced, hashed on the way; it is never held in memory as a whole.
+    Sha256 hash;
+    std::uintmax_t size = 0;
+    {
+        BlobSink sink(temp, hash);
+        std::ostream stream(&sink);
+        stream.exceptions(std::ios::badbit);
+        write(stream);
+        stream.flush();
+        size = sink.commit();
+    }
+
+    const auto digest = Sha256::ToHex(hash.Final());
+    const auto blob   = blob_path(digest);
+    {
+        // Under the lock so the sweeper cannot delete a blob between the dedup check and taking the reference.
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (blob_refs_[digest]++ > 0 || fs::exists(blob)) {
+            fs::remove(temp);
+        } else {
+            fs::create_directories(blob.parent_path());
+            fs::rename(temp, blob);
+        }
+    }
+
+    const auto id = next_id();
+    Entry entry;
+    entry.item.tags         = tags;
+    entry.item.location     = location_of(id);
+    entry.item.contentType  = kContentType;
+    entry.item.lastModified = Clock::now();
+    if (ttl) {
+        entry.item.expires = entry.item.lastModified + *ttl;
+    }
+    entry.blob = digest;
+    entry.size = size;
+
+    nlohmann::json record{{"tags", TagsToJson(tags)},
+                          {"blob", digest},
+                          {"size", size},
+                          {"content_type", entry.item.contentType},
+                          {"last_modified", ToMillis(entry.item.lastModified)}};
+    if (entry.item.expires) {
+        record["expires"] = ToMillis(*entry.item.expires);
+    }
+
+    try {
+        WriteFileAtomically(temp_path(), item_path(id), record.dump());
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        release_blob(digest);
+        throw;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = items_.emplace(id, std::move(entry));
+    return it->second.item;
+}
+
+void LocalStorageClient::release_blob(const std::string& hash) {
+    auto it = blob_refs_.find(hash);
+    if (it == blob_refs_.end() || --it->second > 0) {
+        return;
+    }
+    blob_refs_.erase(it);
+
+    std::error_code ec;
+    fs::remove(blob_path(hash), ec);
+}
+
+StorageItemList LocalStorageClient::list_items(const StorageItemTags& tags, size_t limit) { return list_from(tags, limit, {}); }
+
+StorageItemList LocalStorageClient::get_next_page_of_items(const StorageItemList& page) {
+    if (page.complete || page.continuation.empty()) {
+        StorageItemList last;
+        last.complete = true;
+        return last;
+    }
+
+    auto continuation = nlohmann::json::parse(page.continuation, nullptr, false);
+    if (continuation.is_discarded() || !continuation.contains("tags")) {
+        EURORA_THROW_ERROR(ErrorCode::kInvalidArgument, "Malformed continuation token");
+    }
+    return list_from(TagsFromJson(continuation["tags"]), continuation.at("limit").get<size_t>(), continuation.at("before").get<std::string>());
+}
+
+StorageItemList LocalStorageClient::list_from(const StorageItemTags& tags, size_t limit, const std::string& before) {
+    StorageItemList page;
+    const auto now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = before.empty() ? items_.end() : items_.lower_bound(before);
+
+    // Newest first.
+    while (it != items_.begin()) {
+        --it;
+        const auto& entry = it->second;
+        if (Expired(entry.item, now) || !tags.matches(entry.item.tags)) {
+            continue;
+        }
+        if (page.items.size() == limit) {
+            page.continuation = nlohmann::json{{"tags", TagsToJson(tags)}, {"limit", limit}, {"before", std::next(it)->first}}.dump();
+            return page;
+        }
+        page.items.push_back(entry.item);
+    }
+
+    page.complete = true;
+    return page;
+}
+
+std::shared_ptr<std::istream> LocalStorageClient::get_latest_item(const StorageItemTags& tags) {
+    const auto now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = items_.rbegin(); it != items_.rend(); ++it) {
+        const auto& entry = it->second;
+        if (!Expired(entry.item, now) && tags.matches(entry.item.tags)) {
+            // Mapped while locked: once mapped the sweeper may unlink the blob without affecting the reader.
+            return std::make_shared<io::MappedFileStream>(blob_path(entry.blob));
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<std::istream> LocalStorageClient::get_item_by_url(std::string_view url) {
+    auto slash = url.find_last_of('/');
+    std::string id(slash == std::string_view::npos ? url : url.substr(slash + 1));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = items_.find(id);
+    if (it == items_.end() || Expired(it->second.item, Clock::now())) {
+        return nullptr;
+    }
+    return std::make_shared<io::MappedFileStream>(blob_path(it->second.blob));
+}
+
+std::optional<std::string> LocalStorageClient::health_check() {
+    try {
+        const auto probe = temp_path();
+        WriteFileAtomically(probe, probe.string() + ".probe", "ok");
+        fs::remove(probe.string() + ".probe");
+        return std::nullopt;
+    } catch (const std::exception& e) {
+        return std::string("Local storage at ") + root_.string() + " is not writable: " + e.what();
+    }
+}
+
+void LocalStorageClient::sweep() {
+    std::vector<std::string> expired;
+    const auto now = Clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = items_.begin(); it != items_.end();) {
+            if (!Expired(it->second.item, now)) {
+                ++it;
+                continue;
+            }
+            expired.push_back(it->first);
+            release_blob(it->second.blob);
+            it = items_.erase(it);
+        }
+    }
+
+    for (const auto& id : expired) {
+        std::error_code ec;
+        fs::remove(item_path(id), ec);
+    }
+
+    if (!expired.empty()) {
+        STREAM_INFO() << "Storage sweeper removed " << expired.size() << " expired items.";
+    }
+}
+
+void LocalStorageClient::run_sweeper() {
+    std::unique_lock<std::mutex> lock(sweeper_mutex_);
+    while (!sweeper_cv_.wait_for(lock, sweep_interval_, [this]() { return stopping_; })) {
+        lock.unlock();
+        try {
+            sweep();
+        } catch (const std::exception& e) {
+            STREAM_WARN() << "Storage sweep failed: " << e.what();
+        }
+        lock.lock();
+    }
+}
+
+}  // namespace eurora::core
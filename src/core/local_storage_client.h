@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "eurora_paths.h"
+#include "storage_client.h"
+
+namespace eurora::core {
+
+/**
+ * StorageClient for air-gapped nodes, backed by a directory on the local filesystem.
+ *
+ * Layout under the root:
+ *   blobs/<aa>/<sha256>   payloads, content addressed: storing the same bytes twice keeps one copy
+ *   items/<id>.json       one metadata record per stored item (tags, blob, expiry)
+ *   tmp/                  staging area; files only become visible through rename(2)
+ *
+ * Every file is written to tmp/, fsync'ed and renamed into place, so readers and a crash never observe a partial
+ * payload or record. Items past their TTL are dropped by a background sweeper, and a blob is deleted with the
+ * last item referencing it. Reads memory map the blob instead of copying it into a buffer.
+ *
+ * The index of items is held in memory and rebuilt from items/ on construction; one client per root directory.
+ */
+class LocalStorageClient : public StorageClient {
+public:
+    explicit LocalStorageClient(const std::filesystem::path& root = DefaultStorageFolder(),
+                                std::chrono::seconds sweep_interval = std::chrono::seconds(60));
+    ~LocalStorageClient() override;
+
+    LocalStorageClient(const LocalStorageClient&)            = delete;
+    LocalStorageClient& operator=(const LocalStorageClient&) = delete;
+
+    StorageItemList list_items(const StorageItemTags& tags, size_t limit = 20) override;
+    StorageItemList get_next_page_of_items(const StorageItemList& page) override;
+    std::shared_ptr<std::istream> get_latest_item(const StorageItemTags& tags) override;
+    std::shared_ptr<std::istream> get_item_by_url(std::string_view url) override;
+    StorageItem store_item(const StorageItemTags& tags, std::istream& data, std::optional<std::chrono::seconds> ttl = {}) override;
+    StorageItem store_item_streamed(const StorageItemTags& tags, const StorageWriteFunction& write, std::optional<std::chrono::seconds> ttl = {}) override;
+    /// nullopt when the root is writable, otherwise a description of the problem.
+    std::optional<std::string> health_check() override;
+
+    /// Drops expired items and unreferenced blobs now instead of waiting for the sweeper.
+    void sweep();
+
+    const std::filesystem::path& root() const { return root_; }
+
+private:
+    struct Entry {
+        StorageItem item;
+        std::string blob;
+        std::uintmax_t size = 0;
+    };
+
+    void load();
+    StorageItemList list_from(const StorageItemTags& tags, size_t limit, const std::string& before);
+
+    std::string next_id();
+    std::filesystem::path blob_path(const std::string& hash) const;
+    std::filesystem::path item_path(const std::string& id) const;
+    std::filesystem::path temp_path() const;
+    std::string location_of(const std::string& id) const;
+
+    void release_blob(const std::string& hash);
+
+    void run_sweeper();
+
+private:
+    std::filesystem::path root_;
+    std::chrono::seconds sweep_interval_;
+
+    std::mutex mutex_;
+    std::map<std::string, Entry> items_;  // Ids sort chronologically.
+    std::unordered_map<std::string, std::size_t> blob_refs_;
+
+    std::atomic<uint32_t> sequence_{0};
+
+    std::mutex sweeper_mutex_;
+    std::condition_variable sweeper_cv_;
+    bool stopping_ = false;
+    std::thread sweeper_;
+};
+
+}  // namespace eurora::core
@@ -1,3 +1,11 @@
+#pragma once
+
+#include <optional>
+
+#include "message.h"
+
+namespace Core::Messaging {
+
 /*** Base Channel definition ***/
 class Channel {
 public:
@@ -7,3 +15,5 @@ public:
     virtual std::optional<Message> pop() = 0;
     virtual void close()                 = 0;
 };
+
+}  // namespace Core::Messaging
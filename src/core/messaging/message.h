@@ -2,7 +2,7 @@
 
 #include <memory>
 #include <vector>
-#include "MessageChunk.h"
+#include "message_chunk.h"
 
 namespace Core::Messaging {
 
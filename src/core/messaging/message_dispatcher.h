@@ -3,7 +3,7 @@
 #include <functional>
 #include <typeindex>
 #include <unordered_map>
-#include "Message.h"
+#include "message.h"
 
 namespace Core::Messaging {
 
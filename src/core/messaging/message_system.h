@@ -1,7 +1,7 @@
 #pragma once
 
-#include "Message.h"
-#include "MessageBuilder.h"
-#include "MessageChunk.h"
-#include "MessageDispatcher.h"
-#include "MessageUnpacker.h"
+#include "message.h"
+#include "message_builder.h"
+#include "message_chunk.h"
+#include "message_dispatcher.h"
+#include "message_unpacker.h"
@@ -2,7 +2,7 @@
 
 #include <stdexcept>
 #include <tuple>
-#include "Message.h"
+#include "message.h"
 
 namespace Core::Messaging {
 
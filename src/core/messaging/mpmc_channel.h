@@ -1,14 +1,29 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <iterator>
 #include <list>
 #include <mutex>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+#include "eurora/utils/trace.h"
 
 namespace eurora::core {
 
 template <class T>
 class MPMCChannel {
+    class pop_awaiter;
+
 public:
     MPMCChannel() : size_(0) {}
 
@@ -17,19 +32,81 @@ public:
     void push(T);
     template <class... ARGS>
     void emplace(ARGS&&... args);
+    /// Moves all of `items` into the channel with one lock acquisition and one notify; nodes are allocated unlocked.
+    template <std::ranges::input_range Range>
+    void push_bulk(Range&& items);
 
     T pop();
-    optional<T> try_pop();
+    std::optional<T> try_pop();
+    /// Waits for at least one item, then takes up to `max` under one lock acquisition and moves them to `out` unlocked.
+    template <std::output_iterator<T> OutputIt>
+    size_t pop_bulk(OutputIt out, size_t max);
+
+    /// pop() that returns empty once `token` is cancelled, even with items left, without closing the channel.
+    std::optional<T> pop(std::stop_token token);
+    /// pop() that also returns empty at `deadline`, e.g. to flush a partial batch when its time window closes.
+    std::optional<T> pop_until(std::chrono::steady_clock::time_point deadline, std::stop_token token = {});
+    template <class Rep, class Period>
+    std::optional<T> pop_for(std::chrono::duration<Rep, Period> timeout, std::stop_token token = {}) {
+        return pop_until(std::chrono::steady_clock::now() + timeout, std::move(token));
+    }
+    /// pop_bulk() that returns 0 at `deadline` or once `token` is cancelled.
+    template <std::output_iterator<T> OutputIt>
+    size_t pop_bulk_until(OutputIt out, size_t max, std::chrono::steady_clock::time_point deadline, std::stop_token token = {});
+
+    /**
+     * pop() for coroutines: `T item = co_await channel.async_pop();` suspends instead of blocking a thread while the
+     * channel is empty, and throws ChannelClosed like pop(). The push that provides the item, or close(), resumes the
+     * coroutine on its own thread once the lock is released; `co_await pool.Schedule()` moves it on from there.
+     * Suspended pops are served before blocked ones and must be resumed by close() before the channel is destroyed.
+     */
+    pop_awaiter async_pop() { return pop_awaiter(*this); }
 
     void close();
     size_t size() const;  // 新增的接口：获取当前队列大小
     bool empty() const;   // 新增的接口：判断队列是否为空
 
 private:
+    class pop_awaiter {
+    public:
+        explicit pop_awaiter(MPMCChannel& channel) : channel_(channel) {}
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle);
+        T await_resume();
+
+    private:
+        friend class MPMCChannel;
+
+        MPMCChannel& channel_;
+        std::coroutine_handle<> handle_;
+        std::optional<T> value_;
+    };
+
+    // Hands the item straight to the longest suspended async_pop() if there is one, else queues it. Returns the
+    // coroutine to resume once m_ is released, or a null handle if a blocked pop() needs a notify instead.
+    template <class... ARGS>
+    std::coroutine_handle<> deliver_locked(ARGS&&... args);
+
     T pop_impl(std::unique_lock<std::mutex>& lock);
+    template <std::output_iterator<T> OutputIt>
+    size_t pop_bulk_impl(OutputIt out, size_t max, const std::optional<std::chrono::steady_clock::time_point>& deadline,
+                         const std::stop_token& token);
+    // Waits for an item, the deadline if any, or cancellation, without polling. Returns whether an item is ready and
+    // throws ChannelClosed when the channel is closed and drained. `token` needs a wake_on_stop() registered.
+    bool wait_ready(std::unique_lock<std::mutex>& lock, const std::optional<std::chrono::steady_clock::time_point>& deadline,
+                    const std::stop_token& token);
+    // Registered before the lock is taken: it runs on the cancelling thread and needs the mutex to notify.
+    auto wake_on_stop(const std::stop_token& token) {
+        return std::stop_callback(token, [this]() {
+            std::lock_guard<std::mutex> lock(m_);
+            cv_.notify_all();
+        });
+    }
 
     std::list<T> queue_;
-    std::atomic<size_t> size_;  // 线程安全的大小统计
+    std::deque<pop_awaiter*> waiters_;  // Suspended async_pop() calls, only ever waiting on an empty queue.
+    std::atomic<size_t> size_;          // 线程安全的大小统计
     bool closed_ = false;
     std::mutex m_;
     std::condition_variable cv_;
@@ -44,7 +121,10 @@ public:
 
 template <class T>
 T MPMCChannel<T>::pop_impl(std::unique_lock<std::mutex>& lock) {
-    cv_.wait(lock, [this]() { return !queue_.empty() || closed_; });
+    if (queue_.empty() && !closed_) {
+        EURORA_TRACE_SCOPE("channel", "MPMCChannel::pop wait");
+        cv_.wait(lock, [this]() { return !queue_.empty() || closed_; });
+    }
 
     if (queue_.empty()) {
         throw ChannelClosed();
@@ -63,46 +143,214 @@ T MPMCChannel<T>::pop() {
 }
 
 template <class T>
-optional<T> MPMCChannel<T>::try_pop() {
+std::optional<T> MPMCChannel<T>::try_pop() {
     std::unique_lock<std::mutex> lock(m_);
     if (queue_.empty()) {
-        return none;
+        return std::nullopt;
     }
     return pop_impl(lock);
 }
 
+template <class T>
+template <class... ARGS>
+std::coroutine_handle<> MPMCChannel<T>::deliver_locked(ARGS&&... args) {
+    if (waiters_.empty()) {
+        queue_.emplace_back(std::forward<ARGS>(args)...);
+        ++size_;  // 更新大小
+        return nullptr;
+    }
+    pop_awaiter* waiter = waiters_.front();
+    waiters_.pop_front();
+    waiter->value_.emplace(std::forward<ARGS>(args)...);
+    return waiter->handle_;
+}
+
 template <class T>
 void MPMCChannel<T>::push(T message) {
+    std::coroutine_handle<> waiter;
     {
         std::lock_guard<std::mutex> lock(m_);
         if (closed_)
             throw ChannelClosed();
-        queue_.emplace_back(std::move(message));
-        ++size_;  // 更新大小
+        waiter = deliver_locked(std::move(message));
+    }
+    if (waiter) {
+        waiter.resume();
+    } else {
+        cv_.notify_one();
     }
-    cv_.notify_one();
 }
 
 template <class T>
 template <class... ARGS>
 void MPMCChannel<T>::emplace(ARGS&&... args) {
+    std::coroutine_handle<> waiter;
     {
         std::lock_guard<std::mutex> guard(m_);
         if (closed_)
             throw ChannelClosed();
-        queue_.emplace_back(std::forward<ARGS>(args)...);
-        ++size_;  // 更新大小
+        waiter = deliver_locked(std::forward<ARGS>(args)...);
+    }
+    if (waiter) {
+        waiter.resume();
+    } else {
+        cv_.notify_one();
+    }
+}
+
+template <class T>
+template <std::ranges::input_range Range>
+void MPMCChannel<T>::push_bulk(Range&& items) {
+    std::list<T> batch;
+    for (auto&& item : items) {
+        batch.emplace_back(std::move(item));
+    }
+    std::vector<std::coroutine_handle<>> resumed;
+    size_t count = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        if (closed_)
+            throw ChannelClosed();
+        while (!waiters_.empty() && !batch.empty()) {
+            resumed.push_back(deliver_locked(std::move(batch.front())));
+            batch.pop_front();
+        }
+        count = batch.size();
+        queue_.splice(queue_.end(), batch);
+        size_ += count;
+    }
+    if (count == 1) {
+        cv_.notify_one();
+    } else if (count > 1) {
+        cv_.notify_all();
+    }
+    for (auto waiter : resumed) {
+        waiter.resume();
+    }
+}
+
+template <class T>
+template <std::output_iterator<T> OutputIt>
+size_t MPMCChannel<T>::pop_bulk(OutputIt out, size_t max) {
+    return pop_bulk_impl(out, max, std::nullopt, {});
+}
+
+template <class T>
+bool MPMCChannel<T>::wait_ready(std::unique_lock<std::mutex>& lock, const std::optional<std::chrono::steady_clock::time_point>& deadline,
+                                const std::stop_token& token) {
+    auto ready = [this, &token]() { return !queue_.empty() || closed_ || token.stop_requested(); };
+    if (!ready()) {
+        EURORA_TRACE_SCOPE("channel", "MPMCChannel::pop wait");
+        if (!deadline) {
+            cv_.wait(lock, ready);
+        } else if (!cv_.wait_until(lock, *deadline, ready)) {
+            return false;
+        }
+    }
+
+    if (token.stop_requested()) {
+        return false;
+    }
+    if (queue_.empty()) {
+        throw ChannelClosed();
+    }
+    return true;
+}
+
+template <class T>
+std::optional<T> MPMCChannel<T>::pop(std::stop_token token) {
+    auto wake = wake_on_stop(token);
+    std::unique_lock<std::mutex> lock(m_);
+    if (!wait_ready(lock, std::nullopt, token)) {
+        return std::nullopt;
+    }
+    return pop_impl(lock);
+}
+
+template <class T>
+std::optional<T> MPMCChannel<T>::pop_until(std::chrono::steady_clock::time_point deadline, std::stop_token token) {
+    auto wake = wake_on_stop(token);
+    std::unique_lock<std::mutex> lock(m_);
+    if (!wait_ready(lock, deadline, token)) {
+        return std::nullopt;
+    }
+    return pop_impl(lock);
+}
+
+template <class T>
+template <std::output_iterator<T> OutputIt>
+size_t MPMCChannel<T>::pop_bulk_until(OutputIt out, size_t max, std::chrono::steady_clock::time_point deadline, std::stop_token token) {
+    return pop_bulk_impl(out, max, deadline, token);
+}
+
+template <class T>
+template <std::output_iterator<T> OutputIt>
+size_t MPMCChannel<T>::pop_bulk_impl(OutputIt out, size_t max, const std::optional<std::chrono::steady_clock::time_point>& deadline,
+                                     const std::stop_token& token) {
+    if (max == 0) {
+        return 0;
     }
-    cv_.notify_one();
+
+    std::list<T> batch;
+    {
+        auto wake = wake_on_stop(token);
+        std::unique_lock<std::mutex> lock(m_);
+        if (!wait_ready(lock, deadline, token)) {
+            return 0;
+        }
+
+        auto last    = queue_.begin();
+        size_t count = 0;
+        for (; count < max && last != queue_.end(); ++count) {
+            ++last;
+        }
+        batch.splice(batch.end(), queue_, queue_.begin(), last);
+        size_ -= count;
+    }
+
+    for (auto& item : batch) {
+        *out++ = std::move(item);
+    }
+    return batch.size();
+}
+
+template <class T>
+bool MPMCChannel<T>::pop_awaiter::await_suspend(std::coroutine_handle<> handle) {
+    std::lock_guard<std::mutex> lock(channel_.m_);
+    if (!channel_.queue_.empty()) {
+        value_.emplace(std::move(channel_.queue_.front()));
+        channel_.queue_.pop_front();
+        --channel_.size_;  // 更新大小
+        return false;
+    }
+    if (channel_.closed_) {
+        return false;
+    }
+    handle_ = handle;
+    channel_.waiters_.push_back(this);
+    return true;
+}
+
+template <class T>
+T MPMCChannel<T>::pop_awaiter::await_resume() {
+    if (!value_) {
+        throw ChannelClosed();
+    }
+    return std::move(*value_);
 }
 
 template <class T>
 void MPMCChannel<T>::close() {
+    std::deque<pop_awaiter*> waiters;
     {
         std::lock_guard<std::mutex> lock(m_);
         closed_ = true;
+        waiters.swap(waiters_);
     }
     cv_.notify_all();
+    for (pop_awaiter* waiter : waiters) {
+        waiter->handle_.resume();
+    }
 }
 
 template <class T>
@@ -0,0 +1,251 @@
+#include "shm_channel.h"
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/types.h"
+#include "eurora/utils/metrics.h"
+
+namespace Core::Messaging {
+
+using eurora::core::Acquisition;
+using eurora::core::AnyImage;
+using eurora::core::Image;
+using eurora::utils::ErrorCode;
+
+namespace {
+
+// Wire tags; images are tagged kImage + index of their type in AnyImage.
+constexpr uint32_t kAcquisition = 1;
+constexpr uint32_t kImage       = 16;
+
+template <std::size_t I = 0, typename F>
+bool ForEachImageType(F&& f) {
+    if constexpr (I < std::variant_size_v<AnyImage>) {
+        return f(std::type_identity<std::variant_alternative_t<I, AnyImage>>{}, kImage + static_cast<uint32_t>(I)) ||
+               ForEachImageType<I + 1>(std::forward<F>(f));
+    } else {
+        return false;
+    }
+}
+
+// First pass: counts bytes so the record can be reserved in one piece.
+struct SizeCounter {
+    std::size_t size = 0;
+
+    void put(const void*, std::size_t bytes) { size += bytes; }
+};
+
+// Second pass: writes into the reserved span of the ring.
+struct RingWriter {
+    std::byte* cursor;
+
+    void put(const void* data, std::size_t bytes) {
+        std::memcpy(cursor, data, bytes);
+        cursor += bytes;
+    }
+};
+
+struct RingReader {
+    const std::byte* cursor;
+    const std::byte* end;
+
+    void get(void* data, std::size_t bytes) {
+        if (static_cast<std::size_t>(end - cursor) < bytes) {
+            EURORA_THROW_ERROR(ErrorCode::kData_UnsupportedFormat, "Truncated record in shared memory channel");
+        }
+        std::memcpy(data, cursor, bytes);
+        cursor += bytes;
+    }
+
+    template <typename T>
+    T get() {
+        T value;
+        get(&value, sizeof(T));
+        return value;
+    }
+};
+
+template <typename Sink, typename T>
+void PutArray(Sink& sink, const nc::NdArray<T>& array) {
+    const uint32_t rows = array.shape().rows;
+    const uint32_t cols = array.shape().cols;
+    sink.put(&rows, sizeof(rows));
+    sink.put(&cols, sizeof(cols));
+    sink.put(array.data(), array.size() * sizeof(T));
+}
+
+template <typename T>
+nc::NdArray<T> GetArray(RingReader& reader) {
+    const auto rows = reader.get<uint32_t>();
+    const auto cols = reader.get<uint32_t>();
+    nc::NdArray<T> array(rows, cols);
+    reader.get(array.data(), array.size() * sizeof(T));
+    return array;
+}
+
+class Encoder {
+public:
+    explicit Encoder(const Message& message) : message_(message) {
+        for (const auto& chunk : message_.chunks()) {
+            metadata_.push_back(SerializedMetadata(*chunk));
+        }
+    }
+
+    template <typename Sink>
+    void encode(Sink& sink) const {
+        const auto count = static_cast<uint32_t>(message_.chunks().size());
+        sink.put(&count, sizeof(count));
+
+        for (std::size_t i = 0; i < message_.chunks().size(); ++i) {
+            encodeChunk(sink, *message_.chunks()[i], metadata_[i]);
+        }
+    }
+
+private:
+    // ISMRMRD only serializes meta containers to streams; do it once, not once per pass.
+    static std::string SerializedMetadata(const MessageChunk& chunk) {
+        std::string serialized;
+        ForEachImageType([&](auto type, uint32_t) {
+            using ImageType = typename decltype(type)::type;
+            if (chunk.type() != typeid(ImageType)) {
+                return false;
+            }
+            const auto& image = static_cast<const TypedMessageChunk<ImageType>&>(chunk).data();
+            if (image.metadata) {
+                std::stringstream stream;
+                ISMRMRD::serialize(*image.metadata, stream);
+                serialized = stream.str();
+            }
+            return true;
+        });
+        return serialized;
+    }
+
+    template <typename Sink>
+    static void encodeChunk(Sink& sink, const MessageChunk& chunk, const std::string& metadata) {
+        if (chunk.type() == typeid(Acquisition)) {
+            const auto& acq = static_cast<const TypedMessageChunk<Acquisition>&>(chunk).data();
+            const uint8_t has_trajectory = acq.trajectory.has_value();
+
+            sink.put(&kAcquisition, sizeof(kAcquisition));
+            sink.put(&acq.header, sizeof(acq.header));
+            PutArray(sink, acq.kspace_data);
+            sink.put(&has_trajectory, sizeof(has_trajectory));
+            if (has_trajectory) {
+                PutArray(sink, *acq.trajectory);
+            }
+            return;
+        }
+
+        bool encoded = ForEachImageType([&](auto type, uint32_t tag) {
+            using ImageType = typename decltype(type)::type;
+            if (chunk.type() != typeid(ImageType)) {
+                return false;
+            }
+            const auto& image          = static_cast<const TypedMessageChunk<ImageType>&>(chunk).data();
+            const uint64_t meta_length = metadata.size();
+
+            sink.put(&tag, sizeof(tag));
+            sink.put(&image.header, sizeof(image.header));
+            PutArray(sink, image.image_data);
+            sink.put(&meta_length, sizeof(meta_length));
+            sink.put(metadata.data(), metadata.size());
+            return true;
+        });
+
+        if (!encoded) {
+            EURORA_THROW_ERROR(ErrorCode::kData_UnsupportedFormat, std::string("Shared memory channel cannot carry ") + chunk.type().name());
+        }
+    }
+
+    const Message& message_;
+    std::vector<std::string> metadata_;
+};
+
+void DecodeChunk(RingReader& reader, Message& message) {
+    const auto tag = reader.get<uint32_t>();
+
+    if (tag == kAcquisition) {
+        auto header = reader.get<ISMRMRD::AcquisitionHeader>();
+        auto kspace = GetArray<std::complex<float>>(reader);
+        std::optional<nc::NdArray<float>> trajectory;
+        if (reader.get<uint8_t>() != 0) {
+            trajectory = GetArray<float>(reader);
+        }
+        message.add(Acquisition(header, std::move(kspace), std::move(trajectory)));
+
+        static auto& received =
+            eurora::utils::MetricsRegistry::Instance().GetCounter("eurora_acquisitions_total", "Acquisitions received over shared memory channels.");
+        received.Increment();
+        return;
+    }
+
+    bool decoded = ForEachImageType([&](auto type, uint32_t image_tag) {
+        using ImageType = typename decltype(type)::type;
+        if (tag != image_tag) {
+            return false;
+        }
+        using T = typename decltype(ImageType::image_data)::value_type;
+
+        auto header = reader.get<ISMRMRD::ImageHeader>();
+        auto data   = GetArray<T>(reader);
+
+        std::optional<ISMRMRD::MetaContainer> metadata;
+        if (auto length = reader.get<uint64_t>(); length > 0) {
+            std::string serialized(length, '\0');
+            reader.get(serialized.data(), length);
+            metadata.emplace();
+            ISMRMRD::deserialize(serialized.c_str(), *metadata);
+        }
+        message.add(ImageType(header, std::move(data), std::move(metadata)));
+        return true;
+    });
+
+    if (!decoded) {
+        EURORA_THROW_ERROR(ErrorCode::kData_UnsupportedFormat, "Unknown chunk tag in shared memory channel: " + std::to_string(tag));
+    }
+}
+
+}  // namespace
+
+void ShmChannel::push(Message message) {
+    Encoder encoder(message);
+
+    SizeCounter counter;
+    encoder.encode(counter);
+
+    std::lock_guard<std::mutex> lock(push_mutex_);
+    auto span = ring_.Reserve(counter.size);
+    RingWriter writer{span.data()};
+    encoder.encode(writer);
+    ring_.Commit();
+}
+
+std::optional<Message> ShmChannel::pop() {
+    std::lock_guard<std::mutex> lock(pop_mutex_);
+
+    auto record = ring_.Peek();
+    if (!record) {
+        return std::nullopt;
+    }
+
+    Message message;
+    try {
+        RingReader reader{record->data(), record->data() + record->size()};
+        for (auto count = reader.get<uint32_t>(); count > 0; --count) {
+            DecodeChunk(reader, message);
+        }
+    } catch (...) {
+        ring_.Release();
+        throw;
+    }
+
+    ring_.Release();
+    return message;
+}
+
+}  // namespace Core::Messaging
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <mutex>
+#include <optional>
+
+#include "channel.h"
+#include "shm_ring.hpp"
+
+namespace Core::Messaging {
+
+/**
+ * Channel backed by a shared-memory ring, for peers on the same host.
+ *
+ * Chunks of type Acquisition and Image<T> (every AnyImage alternative) are encoded straight into the ring: headers
+ * and array data are copied once into shared memory and once out of it, with no socket and no serialization
+ * buffer in between. Other chunk types are rejected.
+ *
+ * A ShmChannel carries one direction; use two for a duplex link. Any number of threads may push on the producing
+ * side and pop on the consuming side, they are serialized onto the single-producer single-consumer ring.
+ */
+class ShmChannel : public Channel {
+public:
+    explicit ShmChannel(ShmRing ring) : ring_(std::move(ring)) {}
+
+    /// Throws RingClosed after close(), and an invalid argument error if the message exceeds the ring.
+    void push(Message message) override;
+    /// Blocks for the next message; nullopt once the channel is closed and drained.
+    std::optional<Message> pop() override;
+    void close() override { ring_.Close(); }
+
+    const ShmRing& ring() const { return ring_; }
+
+private:
+    ShmRing ring_;
+    std::mutex push_mutex_;
+    std::mutex pop_mutex_;
+};
+
+}  // namespace Core::Messaging
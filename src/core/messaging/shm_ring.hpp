@@ -0,0 +1,325 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "eurora/utils/exception.hpp"
+
+EURORA_DEFINE_EXCEPTION(RingClosed)
+
+namespace Core::Messaging {
+
+/**
+ * Single-producer single-consumer byte ring in shared memory, usable across processes.
+ *
+ * Records are written in place: the producer reserves a contiguous span inside the mapping, fills it and commits;
+ * the consumer peeks at the same bytes and releases them. Only the head and tail offsets travel between peers,
+ * and a futex on a sequence counter wakes a blocked side, so an uncontended push or pop makes no system call.
+ *
+ * The segment is either named (shm_open, for unrelated processes) or anonymous (memfd_create, share the fd with
+ * SCM_RIGHTS or across fork). Exactly one thread may produce and one may consume at a time.
+ */
+class ShmRing {
+public:
+    static ShmRing Create(const std::string& name, std::size_t capacity);
+    static ShmRing Open(const std::string& name);
+    static ShmRing CreateAnonymous(std::size_t capacity);
+    /// Maps a segment created elsewhere; takes ownership of `fd`.
+    static ShmRing FromFd(int fd);
+
+    ShmRing(ShmRing&& other) noexcept;
+    ShmRing& operator=(ShmRing&& other) noexcept;
+    ~ShmRing();
+
+    ShmRing(const ShmRing&)            = delete;
+    ShmRing& operator=(const ShmRing&) = delete;
+
+    int Fd() const { return fd_; }
+    std::size_t Capacity() const { return header_->capacity; }
+    /// Largest record that is guaranteed to fit, wrap-around included.
+    std::size_t MaxRecordSize() const { return Capacity() / 2 - kRecordHeaderSize; }
+
+    /// Blocks until `size` contiguous bytes are free. Throws RingClosed once the ring is closed.
+    std::span<std::byte> Reserve(std::size_t size);
+    /// Publishes the span returned by the last Reserve().
+    void Commit();
+
+    /// Blocks until a record is available; nullopt once the ring is closed and drained.
+    std::optional<std::span<const std::byte>> Peek();
+    /// Returns the record returned by the last Peek() to the producer.
+    void Release();
+
+    void Close();
+    bool Closed() const { return header_->closed.load(std::memory_order_acquire) != 0; }
+
+private:
+    static constexpr uint64_t kMagic               = 0x45555252494e4731ULL;  // "EURRING1"
+    static constexpr std::size_t kAlignment        = 8;
+    static constexpr std::size_t kRecordHeaderSize = 8;
+    static constexpr uint32_t kPaddingRecord       = 1;
+
+    struct alignas(64) Header {
+        uint64_t magic;
+        uint64_t capacity;
+
+        alignas(64) std::atomic<uint64_t> head;  // Bytes committed, monotonic; written by the producer.
+        std::atomic<uint32_t> data_seq;
+        std::atomic<uint32_t> data_waiters;
+
+        alignas(64) std::atomic<uint64_t> tail;  // Bytes released, monotonic; written by the consumer.
+        std::atomic<uint32_t> space_seq;
+        std::atomic<uint32_t> space_waiters;
+
+        alignas(64) std::atomic<uint32_t> closed;
+    };
+
+    struct RecordHeader {
+        uint32_t size;
+        uint32_t flags;
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+                  "Shared memory rings need address-free atomics");
+    static_assert(sizeof(RecordHeader) == kRecordHeaderSize);
+
+    // `initialize` formats a freshly truncated segment; named segments created here are unlinked on destruction.
+    ShmRing(int fd, std::string name, bool initialize);
+
+    static std::size_t Align(std::size_t size) { return (size + kAlignment - 1) & ~(kAlignment - 1); }
+    static std::size_t MappingSize(std::size_t capacity) { return sizeof(Header) + capacity; }
+
+    static void FutexWait(std::atomic<uint32_t>& word, uint32_t expected) {
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+    }
+    static void FutexWakeAll(std::atomic<uint32_t>& word) {
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+
+    static void Signal(std::atomic<uint32_t>& seq, std::atomic<uint32_t>& waiters) {
+        seq.fetch_add(1, std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_seq_cst) != 0) {
+            FutexWakeAll(seq);
+        }
+    }
+
+    std::byte* Data() const { return reinterpret_cast<std::byte*>(header_) + sizeof(Header); }
+    RecordHeader* RecordAt(uint64_t position) const { return reinterpret_cast<RecordHeader*>(Data() + position % Capacity()); }
+
+    void Unmap();
+
+private:
+    int fd_ = -1;
+    std::string name_;
+    bool owner_     = false;
+    Header* header_ = nullptr;
+
+    // Producer side of an open Reserve().
+    uint64_t reserved_at_      = 0;
+    std::size_t reserved_size_ = 0;
+
+    // Consumer side of an open Peek().
+    std::size_t peeked_size_ = 0;
+};
+
+/** Implementation **/
+
+inline ShmRing::ShmRing(int fd, std::string name, bool initialize) : fd_(fd), name_(std::move(name)), owner_(initialize && !name_.empty()) {
+    struct stat st {};
+    if (::fstat(fd_, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+        ::close(fd_);
+        EURORA_THROW_ERROR(eurora::utils::ErrorCode::kIO_ReadError, "Shared memory segment is not a ring: " + name_);
+    }
+
+    void* mapping = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        ::close(fd_);
+        EURORA_THROW_ERROR(eurora::utils::ErrorCode::kMemory_AllocationFailed, "mmap of shared memory ring failed: " + std::string(std::strerror(errno)));
+    }
+    header_ = static_cast<Header*>(mapping);
+
+    if (initialize) {
+        // A freshly truncated segment is zero filled, which is the empty state of every counter in the header.
+        header_->magic    = kMagic;
+        header_->capacity = static_cast<uint64_t>(st.st_size) - sizeof(Header);
+    } else if (header_->magic != kMagic || MappingSize(header_->capacity) != static_cast<std::size_t>(st.st_size)) {
+        Unmap();
+        EURORA_THROW_ERROR(eurora::utils::ErrorCode::kData_UnsupportedFormat, "Shared memory segment is not a ring: " + name_);
+    }
+}
+
+inline ShmRing ShmRing::Create(const std::string& name, std::size_t capacity) {
+    int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        EURORA_THROW_ERROR(eurora::utils::ErrorCode::kIO_FileOpenFailed, "shm_open " + name + ": " + std::strerror(errno));
+    }
+    if (::ftruncate(fd, static_cast<off_t>(MappingSize(Align(capacity)))) != 0) {
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        EURORA_THROW_ERROR(eurora::utils::ErrorCode::kMemory_AllocationFailed, "ftruncate " + name + ": " + std::strerror(errno));
+    }
+    return ShmRing(fd, name, true);
+}
+
+inline ShmRing ShmRing::Open(const std::string& name) {
+    int fd = ::shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        EURORA_THROW_ERROR(eurora::utils::ErrorCode::kIO_FileOpenFailed, "shm_open " + name + ": " + std::strerror(errno));
+    }
+    return ShmRing(fd, name, false);
+}
+
+inline ShmRing ShmRing::CreateAnonymous(std::size_t capacity) {
+    int fd = ::memfd_create("eurora-ring", MFD_CLOEXEC);
+    if (fd < 0) {
+        EURORA_THROW_ERROR(eurora::utils::ErrorCode::kMemory_AllocationFailed, std::string("memfd_create: ") + std::strerror(errno));
+    }
+    if (::ftruncate(fd, static_cast<off_t>(MappingSize(Align(capacity)))) != 0) {
+        ::close(fd);
+        EURORA_THROW_ERROR(eurora::utils::ErrorCode::kMemory_AllocationFailed, std::string("ftruncate: ") + std::strerror(errno));
+    }
+    return ShmRing(fd, {}, true);
+}
+
+inline ShmRing ShmRing::FromFd(int fd) { return ShmRing(fd, {}, false); }
+
+inline ShmRing::ShmRing(ShmRing&& other) noexcept
+    : fd_(std::exchange(other.fd_, -1)),
+      name_(std::move(other.name_)),
+      owner_(std::exchange(other.owner_, false)),
+      header_(std::exchange(other.header_, nullptr)),
+      reserved_at_(other.reserved_at_),
+      reserved_size_(other.reserved_size_),
+      peeked_size_(other.peeked_size_) {}
+
+inline ShmRing& ShmRing::operator=(ShmRing&& other) noexcept {
+    if (this != &other) {
+        Unmap();
+        fd_            = std::exchange(other.fd_, -1);
+        name_          = std::move(other.name_);
+        owner_         = std::exchange(other.owner_, false);
+        header_        = std::exchange(other.header_, nullptr);
+        reserved_at_   = other.reserved_at_;
+        reserved_size_ = other.reserved_size_;
+        peeked_size_   = other.peeked_size_;
+    }
+    return *this;
+}
+
+inline ShmRing::~ShmRing() { Unmap(); }
+
+inline void ShmRing::Unmap() {
+    if (header_) {
+        ::munmap(header_, MappingSize(header_->capacity));
+        header_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    if (owner_) {
+        ::shm_unlink(name_.c_str());
+        owner_ = false;
+    }
+}
+
+inline std::span<std::byte> ShmRing::Reserve(std::size_t size) {
+    if (size > MaxRecordSize()) {
+        EURORA_THROW_ERROR(eurora::utils::ErrorCode::kInvalidArgument,
+                           "Record of " + std::to_string(size) + " bytes exceeds ring limit of " + std::to_string(MaxRecordSize()));
+    }
+
+    const std::size_t record   = Align(kRecordHeaderSize + size);
+    const uint64_t head        = header_->head.load(std::memory_order_relaxed);
+    const std::size_t offset   = head % Capacity();
+    const std::size_t padding  = Capacity() - offset < record ? Capacity() - offset : 0;
+    const std::size_t required = padding + record;
+
+    auto has_space = [&]() { return Capacity() - (head - header_->tail.load(std::memory_order_acquire)) >= required; };
+
+    while (!has_space()) {
+        if (Closed()) {
+            throw RingClosed();
+        }
+        const uint32_t seq = header_->space_seq.load(std::memory_order_seq_cst);
+        header_->space_waiters.fetch_add(1, std::memory_order_seq_cst);
+        if (!has_space() && !Closed()) {
+            FutexWait(header_->space_seq, seq);
+        }
+        header_->space_waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+    if (Closed()) {
+        throw RingClosed();
+    }
+
+    // Records never straddle the end of the buffer; the tail of the buffer is skipped with a padding record.
+    if (padding != 0) {
+        *RecordAt(head) = RecordHeader{static_cast<uint32_t>(padding - kRecordHeaderSize), kPaddingRecord};
+    }
+
+    reserved_at_   = head + padding;
+    reserved_size_ = size;
+    return {reinterpret_cast<std::byte*>(RecordAt(reserved_at_) + 1), size};
+}
+
+inline void ShmRing::Commit() {
+    *RecordAt(reserved_at_) = RecordHeader{static_cast<uint32_t>(reserved_size_), 0};
+    header_->head.store(reserved_at_ + Align(kRecordHeaderSize + reserved_size_), std::memory_order_release);
+    Signal(header_->data_seq, header_->data_waiters);
+}
+
+inline std::optional<std::span<const std::byte>> ShmRing::Peek() {
+    while (true) {
+        uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+
+        if (header_->head.load(std::memory_order_acquire) != tail) {
+            const RecordHeader* record = RecordAt(tail);
+            if (record->flags == kPaddingRecord) {
+                header_->tail.store(tail + kRecordHeaderSize + record->size, std::memory_order_release);
+                continue;
+            }
+            peeked_size_ = record->size;
+            return std::span<const std::byte>(reinterpret_cast<const std::byte*>(record + 1), record->size);
+        }
+
+        const uint32_t seq = header_->data_seq.load(std::memory_order_seq_cst);
+        header_->data_waiters.fetch_add(1, std::memory_order_seq_cst);
+        const bool empty = header_->head.load(std::memory_order_seq_cst) == tail;
+        if (empty && Closed()) {
+            header_->data_waiters.fetch_sub(1, std::memory_order_seq_cst);
+            return std::nullopt;
+        }
+        if (empty) {
+            FutexWait(header_->data_seq, seq);
+        }
+        header_->data_waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+}
+
+inline void ShmRing::Release() {
+    const uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+    header_->tail.store(tail + Align(kRecordHeaderSize + peeked_size_), std::memory_order_release);
+    Signal(header_->space_seq, header_->space_waiters);
+}
+
+inline void ShmRing::Close() {
+    header_->closed.store(1, std::memory_order_release);
+    Signal(header_->data_seq, header_->data_waiters);
+    Signal(header_->space_seq, header_->space_waiters);
+}
+
+}  // namespace Core::Messaging
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace eurora::core::numa {
+
+/// One NUMA node and the CPUs that belong to it.
+struct Node {
+    int id;
+    std::vector<int> cpus;
+};
+
+/// Allocations at least this large get their own pages bound to a node; smaller ones come from the heap.
+inline constexpr std::size_t kNodeLocalThreshold = std::size_t(64) << 10;
+
+/// Parses a kernel CPU or node list such as "0-3,8,10-11".
+std::vector<int> ParseList(const std::string& list);
+
+/// The online NUMA nodes from sysfs. Without NUMA support this is a single node 0 holding every CPU.
+std::vector<Node> Nodes();
+
+/// The node the calling thread is running on right now, 0 if it cannot be determined.
+int CurrentNode();
+
+/// The node holding the page at `address`, faulting it in first if needed; empty without NUMA support.
+std::optional<int> NodeOfAddress(const void* address);
+
+/// Restricts the calling thread to `cpus`. Returns false if the kernel refused, e.g. for offline CPUs.
+bool PinCurrentThread(const std::vector<int>& cpus);
+
+/**
+ * Prefers `node` for the whole pages inside [address, address + bytes) and migrates pages already faulted in
+ * elsewhere. A preference, not a binding: when the node is out of memory the kernel still allocates elsewhere.
+ */
+bool BindMemory(void* address, std::size_t bytes, int node);
+
+/// BindMemory() over the storage of a contiguous container, e.g. an NdArray or std::vector, after it was filled.
+template <typename Container>
+bool BindBuffer(Container& buffer, int node) {
+    return BindMemory(static_cast<void*>(buffer.data()), buffer.size() * sizeof(*buffer.data()), node);
+}
+
+/**
+ * Allocator placing large buffers on one NUMA node; use it as the allocator of NdArray or std::vector buffers.
+ *
+ * A default constructed allocator uses the node of the thread that allocates, so buffers created inside a task on
+ * a node-pinned ThreadPool group live next to the workers that process them.
+ */
+template <typename T>
+class NodeLocalAllocator {
+public:
+    using value_type = T;
+
+    NodeLocalAllocator() noexcept = default;
+    explicit NodeLocalAllocator(int node) noexcept : node_(node) {}
+
+    template <typename U>
+    NodeLocalAllocator(const NodeLocalAllocator<U>& other) noexcept : node_(other.node()) {}
+
+    /// The node buffers are placed on; -1 for the node of the allocating thread.
+    int node() const noexcept { return node_; }
+
+    T* allocate(std::size_t count);
+
+    void deallocate(T* pointer, std::size_t count) noexcept;
+
+    template <typename U>
+    bool operator==(const NodeLocalAllocator<U>& other) const noexcept {
+        return node_ == other.node();
+    }
+
+private:
+    int node_ = -1;
+};
+
+/** Implementation **/
+
+inline std::vector<int> ParseList(const std::string& list) {
+    std::vector<int> values;
+    std::stringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        const auto dash = range.find('-');
+        const int first = std::stoi(range.substr(0, dash));
+        const int last  = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int value = first; value <= last; ++value) {
+            values.push_back(value);
+        }
+    }
+    return values;
+}
+
+inline std::vector<Node> Nodes() {
+    std::vector<Node> nodes;
+
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string list;
+    if (online && std::getline(online, list)) {
+        for (int id : ParseList(list)) {
+            std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist");
+            std::string cpus;
+            std::getline(cpulist, cpus);
+            // Memory-only nodes, e.g. CXL expanders, have no CPUs to run workers on.
+            if (auto parsed = ParseList(cpus); !parsed.empty()) {
+                nodes.push_back({id, std::move(parsed)});
+            }
+        }
+    }
+
+    if (nodes.empty()) {
+        Node node{0, {}};
+        for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu) {
+            node.cpus.push_back(static_cast<int>(cpu));
+        }
+        nodes.push_back(std::move(node));
+    }
+    return nodes;
+}
+
+inline int CurrentNode() {
+    unsigned cpu  = 0;
+    unsigned node = 0;
+    if (::syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+        return 0;
+    }
+    return static_cast<int>(node);
+}
+
+inline std::optional<int> NodeOfAddress(const void* address) {
+    int node = -1;
+    if (::syscall(SYS_get_mempolicy, &node, nullptr, 0UL, address, static_cast<unsigned long>(MPOL_F_NODE | MPOL_F_ADDR)) != 0) {
+        return std::nullopt;
+    }
+    return node;
+}
+
+inline bool PinCurrentThread(const std::vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(static_cast<size_t>(cpu), &set);
+        }
+    }
+    return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+}
+
+inline bool BindMemory(void* address, std::size_t bytes, int node) {
+    if (node < 0 || node >= static_cast<int>(sizeof(unsigned long) * 8)) {
+        return false;
+    }
+
+    // mbind works on whole pages; the partial pages at either end stay where they are.
+    const auto page  = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+    const auto begin = (reinterpret_cast<std::uintptr_t>(address) + page - 1) & ~(page - 1);
+    const auto end   = (reinterpret_cast<std::uintptr_t>(address) + bytes) & ~(page - 1);
+    if (end <= begin) {
+        return true;
+    }
+
+    const unsigned long mask = 1UL << node;
+    return ::syscall(SYS_mbind, begin, end - begin, MPOL_PREFERRED, &mask, sizeof(mask) * 8, MPOL_MF_MOVE) == 0;
+}
+
+template <typename T>
+T* NodeLocalAllocator<T>::allocate(std::size_t count) {
+    const std::size_t bytes = count * sizeof(T);
+    if (bytes < kNodeLocalThreshold) {
+        return static_cast<T*>(::operator new(bytes, std::align_val_t(alignof(T))));
+    }
+
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    // No page is touched yet, so the policy decides where every one of them is faulted in.
+    BindMemory(mapping, bytes, node_ >= 0 ? node_ : CurrentNode());
+    return static_cast<T*>(mapping);
+}
+
+template <typename T>
+void NodeLocalAllocator<T>::deallocate(T* pointer, std::size_t count) noexcept {
+    const std::size_t bytes = count * sizeof(T);
+    if (bytes < kNodeLocalThreshold) {
+        ::operator delete(pointer, std::align_val_t(alignof(T)));
+    } else {
+        ::munmap(pointer, bytes);
+    }
+}
+
+}  // namespace eurora::core::numa
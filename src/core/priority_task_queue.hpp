@@ -0,0 +1,178 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "thread_safe_queue.hpp"
+
+namespace eurora::core {
+
+/// Priority class of a task. Interactive work, e.g. images of a patient on the table, runs before everything else.
+enum class TaskPriority { kInteractive, kNormal, kBatch };
+
+inline constexpr std::string_view ToString(TaskPriority priority) {
+    switch (priority) {
+        case TaskPriority::kInteractive:
+            return "interactive";
+        case TaskPriority::kBatch:
+            return "batch";
+        default:
+            return "normal";
+    }
+}
+
+inline std::optional<TaskPriority> ParseTaskPriority(std::string_view text) {
+    for (auto priority : {TaskPriority::kInteractive, TaskPriority::kNormal, TaskPriority::kBatch}) {
+        if (ToString(priority) == text) {
+            return priority;
+        }
+    }
+    return std::nullopt;
+}
+
+/// When a task should run: its priority class and, optionally, the point in time it is due.
+struct TaskSchedule {
+    TaskPriority priority = TaskPriority::kNormal;
+    std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt;
+};
+
+/**
+ * How long a task of each class may wait before it is due, indexed by TaskPriority.
+ *
+ * Tasks run earliest deadline first, and a task without an explicit deadline is due when it was pushed plus the
+ * allowance of its class. So interactive work overtakes batch work pushed up to 30 s before it, but a batch task
+ * that has waited that long is ordered like a fresh interactive one and cannot starve.
+ */
+using AgingAllowances = std::array<std::chrono::steady_clock::duration, 3>;
+
+inline constexpr AgingAllowances kDefaultAgingAllowances = {std::chrono::seconds(0), std::chrono::seconds(1), std::chrono::seconds(30)};
+
+/// The point in time a task pushed at `now` with `schedule` is due.
+inline std::chrono::steady_clock::time_point DueTime(const TaskSchedule& schedule, std::chrono::steady_clock::time_point now,
+                                                     const AgingAllowances& allowances = kDefaultAgingAllowances) {
+    return schedule.deadline.value_or(now + allowances[static_cast<std::size_t>(schedule.priority)]);
+}
+
+/**
+ * ThreadSafeQueue ordered by due time instead of arrival, see AgingAllowances.
+ *
+ * Tasks due at the same time, in particular tasks pushed with the same class and no deadline, keep their arrival
+ * order, so a queue that only ever sees the default schedule behaves like a FIFO.
+ */
+template <typename T>
+class PriorityTaskQueue {
+public:
+    explicit PriorityTaskQueue(AgingAllowances allowances = kDefaultAgingAllowances) : allowances_(allowances) {}
+    ~PriorityTaskQueue() = default;
+
+    PriorityTaskQueue(const PriorityTaskQueue&)            = delete;
+    PriorityTaskQueue& operator=(const PriorityTaskQueue&) = delete;
+
+    PriorityTaskQueue(PriorityTaskQueue&&)            = delete;
+    PriorityTaskQueue& operator=(PriorityTaskQueue&&) = delete;
+
+    void Push(T value, const TaskSchedule& schedule = {});
+
+    T Pop();
+
+    std::optional<T> TryPop();
+
+    void Close();
+
+    bool Empty() const;
+
+    size_t Size() const;
+
+private:
+    struct Entry {
+        std::chrono::steady_clock::time_point due;
+        std::uint64_t sequence;
+        T value;
+    };
+
+    // Heap comparator: the entry due first, then pushed first, is on top.
+    static bool Later(const Entry& a, const Entry& b) { return a.due != b.due ? a.due > b.due : a.sequence > b.sequence; }
+
+    T PopImpl(std::unique_lock<std::mutex> lock);
+
+private:
+    const AgingAllowances allowances_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    std::vector<Entry> heap_;
+    std::uint64_t next_sequence_ = 0;
+    bool closed_                 = false;
+};
+
+/** Implementation **/
+
+template <class T>
+T PriorityTaskQueue<T>::PopImpl(std::unique_lock<std::mutex> lock) {
+    condition_.wait(lock, [this]() { return !this->heap_.empty() || closed_; });
+    if (heap_.empty()) {
+        throw QueueClosed();
+    }
+    std::pop_heap(heap_.begin(), heap_.end(), Later);
+    T value = std::move(heap_.back().value);
+    heap_.pop_back();
+    return value;
+}
+
+template <class T>
+void PriorityTaskQueue<T>::Push(T value, const TaskSchedule& schedule) {
+    const auto due = DueTime(schedule, std::chrono::steady_clock::now(), allowances_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_)
+            throw QueueClosed();
+        heap_.push_back({due, next_sequence_++, std::move(value)});
+        std::push_heap(heap_.begin(), heap_.end(), Later);
+    }
+    condition_.notify_one();
+}
+
+template <class T>
+T PriorityTaskQueue<T>::Pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return PopImpl(std::move(lock));
+}
+
+template <class T>
+std::optional<T> PriorityTaskQueue<T>::TryPop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (heap_.empty()) {
+        return std::nullopt;
+    }
+    return PopImpl(std::move(lock));
+}
+
+template <class T>
+void PriorityTaskQueue<T>::Close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    condition_.notify_all();
+}
+
+template <class T>
+bool PriorityTaskQueue<T>::Empty() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return heap_.empty();
+}
+
+template <class T>
+size_t PriorityTaskQueue<T>::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return heap_.size();
+}
+
+}  // namespace eurora::core
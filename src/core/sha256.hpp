@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace eurora::core {
+
+/**
+ * Incremental SHA-256 (FIPS 180-4). Used to content-address stored payloads, not for anything security sensitive
+ * beyond collision resistance.
+ */
+class Sha256 {
+public:
+    using Digest = std::array<uint8_t, 32>;
+
+    Sha256() { Reset(); }
+
+    void Reset();
+    void Update(const void* data, std::size_t size);
+    Digest Final();
+
+    static std::string ToHex(const Digest& digest);
+    static std::string HexDigest(std::string_view data);
+
+private:
+    void Transform(const uint8_t* block);
+
+    static uint32_t Rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+private:
+    std::array<uint32_t, 8> state_{};
+    std::array<uint8_t, 64> buffer_{};
+    std::size_t buffered_ = 0;
+    uint64_t length_      = 0;
+};
+
+/** Implementation **/
+
+inline void Sha256::Reset() {
+    state_    = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    buffered_ = 0;
+    length_   = 0;
+}
+
+inline void Sha256::Update(const void* data, std::size_t size) {
+    auto bytes = static_cast<const uint8_t*>(data);
+    length_ += size;
+
+    if (buffered_ != 0) {
+        std::size_t take = std::min(size, buffer_.size() - buffered_);
+        std::memcpy(buffer_.data() + buffered_, bytes, take);
+        buffered_ += take;
+        bytes += take;
+        size -= take;
+        if (buffered_ < buffer_.size()) {
+            return;
+        }
+        Transform(buffer_.data());
+        buffered_ = 0;
+    }
+
+    for (; size >= 64; size -= 64, bytes += 64) {
+        Transform(bytes);
+    }
+
+    std::memcpy(buffer_.data(), bytes, size);
+    buffered_ = size;
+}
+
+inline Sha256::Digest Sha256::Final() {
+    const uint64_t bit_length = length_ * 8;
+
+    static constexpr uint8_t kPadding[64] = {0x80};
+    Update(kPadding, buffered_ < 56 ? 56 - buffered_ : 120 - buffered_);
+
+    uint8_t length_bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        length_bytes[i] = static_cast<uint8_t>(bit_length >> (56 - 8 * i));
+    }
+    Update(length_bytes, sizeof(length_bytes));
+
+    Digest digest;
+    for (std::size_t i = 0; i < state_.size(); ++i) {
+        for (std::size_t j = 0; j < 4; ++j) {
+            digest[i * 4 + j] = static_cast<uint8_t>(state_[i] >> static_cast<int>(24 - 8 * j));
+        }
+    }
+    Reset();
+    return digest;
+}
+
+inline std::string Sha256::ToHex(const Digest& digest) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    std::string hex(digest.size() * 2, '0');
+    for (std::size_t i = 0; i < digest.size(); ++i) {
+        hex[2 * i]     = kHex[digest[i] >> 4];
+        hex[2 * i + 1] = kHex[digest[i] & 0xf];
+    }
+    return hex;
+}
+
+inline std::string Sha256::HexDigest(std::string_view data) {
+    Sha256 hash;
+    hash.Update(data.data(), data.size());
+    return ToHex(hash.Final());
+}
+
+inline void Sha256::Transform(const uint8_t* block) {
+    static constexpr uint32_t kRounds[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be,
+        0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa,
+        0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85,
+        0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+        0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f,
+        0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = (uint32_t(block[4 * i]) << 24) | (uint32_t(block[4 * i + 1]) << 16) | (uint32_t(block[4 * i + 2]) << 8) | uint32_t(block[4 * i + 3]);
+    }
+    for (int i = 16; i < 64; ++i) {
+        uint32_t s0 = Rotr(w[i - 15], 7) ^ Rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = Rotr(w[i - 2], 17) ^ Rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i]        = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+    uint32_t e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+
+    for (int i = 0; i < 64; ++i) {
+        uint32_t t1 = h + (Rotr(e, 6) ^ Rotr(e, 11) ^ Rotr(e, 25)) + ((e & f) ^ (~e & g)) + kRounds[i] + w[i];
+        uint32_t t2 = (Rotr(a, 2) ^ Rotr(a, 13) ^ Rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h           = g;
+        g           = f;
+        f           = e;
+        e           = d + t1;
+        d           = c;
+        c           = b;
+        b           = a;
+        a           = t1 + t2;
+    }
+
+    state_[0] += a;
+    state_[1] += b;
+    state_[2] += c;
+    state_[3] += d;
+    state_[4] += e;
+    state_[5] += f;
+    state_[6] += g;
+    state_[7] += h;
+}
+
+}  // namespace eurora::core
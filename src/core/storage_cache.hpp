@@ -0,0 +1,223 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "eurora/utils/metrics.h"
+
+#include "storage_item.h"
+
+namespace eurora::core {
+
+/**
+ * Approximate memory held by a cached value: `nbytes()` when the type reports it (NumCpp arrays), element storage
+ * for contiguous containers of trivially copyable elements, and the object itself otherwise.
+ */
+template <typename T>
+std::size_t CachedSize(const T& value) {
+    if constexpr (requires { value.nbytes(); }) {
+        return sizeof(T) + static_cast<std::size_t>(value.nbytes());
+    } else if constexpr (requires { std::size(value); typename T::value_type; }) {
+        if constexpr (std::is_trivially_copyable_v<typename T::value_type>) {
+            return sizeof(T) + std::size(value) * sizeof(typename T::value_type);
+        }
+    }
+    return sizeof(T);
+}
+
+/**
+ * Byte-bounded LRU of deserialized storage reads, keyed by the query tags and the requested type.
+ *
+ * Entries live for at most `max_age`, as the backing items may expire or be replaced by another process. Writes
+ * through a StorageSpace drop every entry whose query would match the new item. A read that started before such a
+ * write passes the epoch it observed to put(), which discards the value if an invalidation happened meanwhile.
+ *
+ * One cache is meant to be shared by the spaces of a session, so their invalidations see each other. Every cache
+ * also counts into eurora_storage_cache_{hits,misses,evictions,invalidations}_total and publishes its size as
+ * eurora_storage_cache_{entries,bytes}; all caches of the process add up there.
+ */
+class StorageCache {
+public:
+    struct Stats {
+        uint64_t hits          = 0;
+        uint64_t misses        = 0;
+        uint64_t evictions     = 0;
+        uint64_t invalidations = 0;
+        std::size_t entries    = 0;
+        std::size_t bytes      = 0;
+
+        double hit_rate() const { return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses); }
+    };
+
+    explicit StorageCache(std::size_t capacity_bytes, std::chrono::seconds max_age = std::chrono::minutes(5))
+        : capacity_(capacity_bytes),
+          max_age_(max_age),
+          hits_total_(counter("hits", "Storage reads answered from the cache.")),
+          misses_total_(counter("misses", "Storage reads the cache could not answer.")),
+          evictions_total_(counter("evictions", "Cache entries dropped to make room.")),
+          invalidations_total_(counter("invalidations", "Cache entries dropped because a matching item was written.")) {
+        auto& registry = eurora::utils::MetricsRegistry::Instance();
+        metrics_.push_back(registry.AddGaugeCallback("eurora_storage_cache_entries", "Entries held by storage caches.", {},
+                                                     [this]() { return static_cast<double>(stats().entries); }));
+        metrics_.push_back(registry.AddGaugeCallback("eurora_storage_cache_bytes", "Approximate bytes held by storage caches.", {},
+                                                     [this]() { return static_cast<double>(stats().bytes); }));
+    }
+
+    StorageCache(const StorageCache&)            = delete;
+    StorageCache& operator=(const StorageCache&) = delete;
+
+    template <typename T>
+    std::shared_ptr<const T> get(const StorageItemTags& tags);
+
+    /// Caches `value` unless an invalidation happened after `epoch` was read. Values larger than the cache are skipped.
+    template <typename T>
+    void put(const StorageItemTags& tags, const T& value, uint64_t epoch);
+
+    /// Drops every entry whose query matches a newly written item with `item_tags`.
+    void invalidate(const StorageItemTags& item_tags);
+    void clear();
+
+    uint64_t epoch() const { return epoch_.load(std::memory_order_acquire); }
+    std::size_t capacity() const { return capacity_; }
+    Stats stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::string key;
+        std::shared_ptr<const StorageItemTags> tags;
+        std::shared_ptr<const void> value;
+        std::size_t size;
+        Clock::time_point expires;
+    };
+
+    static std::string KeyOf(const StorageItemTags& tags, std::type_index type);
+
+    static eurora::utils::Counter& counter(const char* event, const char* help) {
+        return eurora::utils::MetricsRegistry::Instance().GetCounter(std::string("eurora_storage_cache_") + event + "_total", help);
+    }
+
+    void erase_locked(std::list<Entry>::iterator it);
+
+private:
+    const std::size_t capacity_;
+    const std::chrono::seconds max_age_;
+
+    mutable std::mutex mutex_;
+    std::list<Entry> lru_;  // Most recently used first.
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    std::size_t bytes_ = 0;
+    std::atomic<uint64_t> epoch_{0};
+    Stats stats_;
+
+    eurora::utils::Counter& hits_total_;
+    eurora::utils::Counter& misses_total_;
+    eurora::utils::Counter& evictions_total_;
+    eurora::utils::Counter& invalidations_total_;
+    std::vector<eurora::utils::GaugeCallback> metrics_;  // Declared last: unregistered before what they read goes away.
+};
+
+/** Implementation **/
+
+template <typename T>
+std::shared_ptr<const T> StorageCache::get(const StorageItemTags& tags) {
+    const auto key = KeyOf(tags, typeid(T));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        ++stats_.misses;
+        misses_total_.Increment();
+        return nullptr;
+    }
+    if (it->second->expires <= Clock::now()) {
+        erase_locked(it->second);
+        ++stats_.misses;
+        misses_total_.Increment();
+        return nullptr;
+    }
+
+    lru_.splice(lru_.begin(), lru_, it->second);
+    ++stats_.hits;
+    hits_total_.Increment();
+    return std::static_pointer_cast<const T>(it->second->value);
+}
+
+template <typename T>
+void StorageCache::put(const StorageItemTags& tags, const T& value, uint64_t epoch) {
+    const auto size = CachedSize(value);
+    if (size > capacity_) {
+        return;
+    }
+
+    // Built outside the lock; copying a large array is the expensive part.
+    Entry entry{KeyOf(tags, typeid(T)), std::make_shared<const StorageItemTags>(tags), std::make_shared<const T>(value), size, Clock::now() + max_age_};
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (epoch != epoch_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (auto it = index_.find(entry.key); it != index_.end()) {
+        erase_locked(it->second);
+    }
+    while (bytes_ + size > capacity_ && !lru_.empty()) {
+        erase_locked(std::prev(lru_.end()));
+        ++stats_.evictions;
+        evictions_total_.Increment();
+    }
+
+    bytes_ += size;
+    lru_.push_front(std::move(entry));
+    index_.emplace(lru_.front().key, lru_.begin());
+}
+
+inline void StorageCache::invalidate(const StorageItemTags& item_tags) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    epoch_.fetch_add(1, std::memory_order_release);
+    for (auto it = lru_.begin(); it != lru_.end();) {
+        auto current = it++;
+        if (current->tags->matches(item_tags)) {
+            erase_locked(current);
+            ++stats_.invalidations;
+            invalidations_total_.Increment();
+        }
+    }
+}
+
+inline void StorageCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    epoch_.fetch_add(1, std::memory_order_release);
+    lru_.clear();
+    index_.clear();
+    bytes_ = 0;
+}
+
+inline StorageCache::Stats StorageCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats   = stats_;
+    stats.entries = lru_.size();
+    stats.bytes   = bytes_;
+    return stats;
+}
+
+inline std::string StorageCache::KeyOf(const StorageItemTags& tags, std::type_index type) { return type.name() + tags.key(); }
+
+inline void StorageCache::erase_locked(std::list<Entry>::iterator it) {
+    bytes_ -= it->size;
+    index_.erase(it->key);
+    lru_.erase(it);
+}
+
+}  // namespace eurora::core
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "storage_item.h"
+
+namespace eurora::core {
+
+/// Produces an item's payload by writing it into the sink it is given.
+using StorageWriteFunction = std::function<void(std::ostream&)>;
+
+class StorageClient {
+public:
+    explicit StorageClient(std::string_view base_url) : base_url(std::string(base_url)) {
+        if (base_url.back() == '/') {
+            this->base_url.pop_back();  // Ensure no trailing slash
+        }
+    }
+
+    virtual ~StorageClient() = default;
+
+    virtual StorageItemList list_items(const StorageItemTags& tags, size_t limit = 20) = 0;
+    virtual StorageItemList get_next_page_of_items(const StorageItemList& page) = 0;
+    virtual std::shared_ptr<std::istream> get_latest_item(const StorageItemTags& tags) = 0;
+    virtual std::shared_ptr<std::istream> get_item_by_url(std::string_view url) = 0;
+    virtual StorageItem store_item(const StorageItemTags& tags, std::istream& data, std::optional<std::chrono::seconds> ttl = {}) = 0;
+    virtual std::optional<std::string> health_check() = 0;
+
+    /**
+     * Stores the payload `write` produces. Clients that can consume a stream incrementally override this to hand
+     * `write` their own sink, so the payload is never held in memory as a whole. The default buffers it.
+     */
+    virtual StorageItem store_item_streamed(const StorageItemTags& tags, const StorageWriteFunction& write, std::optional<std::chrono::seconds> ttl = {}) {
+        std::stringstream stream;
+        write(stream);
+        return store_item(tags, stream, ttl);
+    }
+
+private:
+    std::string base_url;
+};
+
+}  // namespace eurora::core
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace eurora::core {
+
+struct StorageItemTags {
+    std::string subject;
+    std::optional<std::string> device;
+    std::optional<std::string> session;
+    std::optional<std::string> name;
+    std::multimap<std::string, std::string> custom_tags;
+
+    /// True when `item` carries every tag set here; tags left unset match anything.
+    bool matches(const StorageItemTags& item) const {
+        if (subject != item.subject) {
+            return false;
+        }
+        if ((device && device != item.device) || (session && session != item.session) || (name && name != item.name)) {
+            return false;
+        }
+        for (const auto& [key, value] : custom_tags) {
+            auto [begin, end] = item.custom_tags.equal_range(key);
+            if (std::none_of(begin, end, [&value](const auto& tag) { return tag.second == value; })) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Canonical string form; equal tag sets give equal keys.
+    std::string key() const;
+
+    class Builder;
+};
+
+inline std::string StorageItemTags::key() const {
+    // Record and unit separators cannot appear in tag values coming from ISMRMRD headers.
+    std::string key;
+    auto append = [&key](char marker, const std::string& value) {
+        key += '\x1e';
+        key += marker;
+        key += value;
+    };
+    append('s', subject);
+    append(device ? 'd' : '-', device.value_or(""));
+    append(session ? 'e' : '-', session.value_or(""));
+    append(name ? 'n' : '-', name.value_or(""));
+    for (const auto& [tag, value] : custom_tags) {
+        append('c', tag + '\x1f' + value);
+    }
+    return key;
+}
+
+class StorageItemTags::Builder {
+public:
+    explicit Builder(std::string_view subject) { tags.subject = std::string(subject); }
+
+    Builder& with_device(std::string_view device) {
+        tags.device = std::string(device);
+        return *this;
+    }
+
+    Builder& with_session(std::string_view session) {
+        tags.session = std::string(session);
+        return *this;
+    }
+
+    Builder& with_name(std::string_view name) {
+        tags.name = std::string(name);
+        return *this;
+    }
+
+    Builder& with_custom_tag(std::string_view tag_name, std::string_view tag_value) {
+        tags.custom_tags.emplace(std::string(tag_name), std::string(tag_value));
+        return *this;
+    }
+
+    StorageItemTags build() const { return tags; }
+
+private:
+    StorageItemTags tags;
+};
+
+struct StorageItem {
+    StorageItemTags tags;
+    std::string location;
+    std::string contentType;
+    std::chrono::time_point<std::chrono::system_clock> lastModified;
+    std::optional<std::chrono::time_point<std::chrono::system_clock>> expires;
+    std::string data;
+};
+
+struct StorageItemList {
+    std::vector<StorageItem> items;
+    bool complete = false;
+    std::string continuation;
+};
+
+}  // namespace eurora::core
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "io/primitives.h"
+#include "storage_client.h"
+
+namespace eurora::core {
+
+/// An item's metadata; the payload is only fetched when asked for.
+class LazyStorageItem {
+public:
+    LazyStorageItem(std::shared_ptr<StorageClient> client, StorageItem item) : client_(std::move(client)), item_(std::move(item)) {}
+
+    const StorageItem& metadata() const { return item_; }
+    const StorageItemTags& tags() const { return item_.tags; }
+    const std::string& location() const { return item_.location; }
+
+    /// Fetches the payload; nullptr if the item has expired or been removed since it was listed.
+    std::shared_ptr<std::istream> open() const { return client_->get_item_by_url(item_.location); }
+
+    template <typename T>
+    std::optional<T> read() const {
+        auto stream = open();
+        if (!stream) {
+            return std::nullopt;
+        }
+        return io::read<T>(*stream);
+    }
+
+private:
+    std::shared_ptr<StorageClient> client_;
+    StorageItem item_;
+};
+
+/**
+ * Walks every item matching `tags`, page by page, while fetching the next page in the background.
+ *
+ * At most the current and the next page are held, and payloads a client returns inline with a listing are dropped,
+ * so scanning thousands of items takes constant memory. Single pass: use either next() or one range-for loop.
+ */
+class StorageItemCursor {
+public:
+    StorageItemCursor(std::shared_ptr<StorageClient> client, StorageItemTags tags, std::size_t page_size = 100)
+        : client_(std::move(client)), tags_(std::move(tags)), page_size_(page_size) {}
+
+    StorageItemCursor(const StorageItemCursor&)            = delete;
+    StorageItemCursor& operator=(const StorageItemCursor&) = delete;
+
+    std::optional<LazyStorageItem> next();
+
+    std::size_t pages_fetched() const { return pages_fetched_; }
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = LazyStorageItem;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const LazyStorageItem*;
+        using reference         = const LazyStorageItem&;
+
+        iterator() = default;
+        explicit iterator(StorageItemCursor* cursor) : cursor_(cursor), current_(cursor->next()) {}
+
+        reference operator*() const { return *current_; }
+        pointer operator->() const { return &*current_; }
+
+        iterator& operator++() {
+            current_ = cursor_->next();
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        bool operator==(std::default_sentinel_t) const { return !current_; }
+
+    private:
+        StorageItemCursor* cursor_ = nullptr;
+        std::optional<LazyStorageItem> current_;
+    };
+
+    iterator begin() { return iterator(this); }
+    std::default_sentinel_t end() const { return std::default_sentinel; }
+
+private:
+    void prefetch();
+    void adopt(StorageItemList page);
+
+private:
+    std::shared_ptr<StorageClient> client_;
+    const StorageItemTags tags_;
+    const std::size_t page_size_;
+
+    bool started_ = false;
+    StorageItemList page_;  // Items are consumed from `position_`; continuation points past them.
+    std::size_t position_ = 0;
+    std::future<StorageItemList> next_page_;  // From std::async, so destroying the cursor waits for it.
+    std::size_t pages_fetched_ = 0;
+};
+
+/** Implementation **/
+
+inline std::optional<LazyStorageItem> StorageItemCursor::next() {
+    if (!started_) {
+        started_ = true;
+        adopt(client_->list_items(tags_, page_size_));
+    }
+
+    while (position_ == page_.items.size()) {
+        if (!next_page_.valid()) {
+            return std::nullopt;
+        }
+        adopt(next_page_.get());
+    }
+
+    return LazyStorageItem(client_, std::move(page_.items[position_++]));
+}
+
+inline void StorageItemCursor::adopt(StorageItemList page) {
+    ++pages_fetched_;
+    for (auto& item : page.items) {
+        std::string().swap(item.data);
+    }
+    page_     = std::move(page);
+    position_ = 0;
+    prefetch();
+}
+
+inline void StorageItemCursor::prefetch() {
+    if (page_.complete || page_.continuation.empty()) {
+        return;
+    }
+    StorageItemList continuation;
+    continuation.continuation = page_.continuation;
+    next_page_ = std::async(std::launch::async, [client = client_, continuation = std::move(continuation)]() {
+        return client->get_next_page_of_items(continuation);
+    });
+}
+
+}  // namespace eurora::core
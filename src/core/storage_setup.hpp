@@ -3,96 +3,39 @@
 #include <chrono>
 #include <filesystem>
 #include <future>
+#include <iostream>
 #include <istream>
 #include <map>
 #include <memory>
 #include <optional>
 #include <ostream>
+#include <sstream>
+#include <string>
 #include <variant>
+#include <vector>
 
-#include "IsmrmrdContextVariables.h"
-#include "io/primitives.h"
+#include "eurora/utils/metrics.h"
+#include "eurora/utils/trace.h"
+#include "ismrmrd_context_variables.h"
+#include "io/array_io.h"
+#include "storage_cache.hpp"
+#include "storage_client.h"
+#include "storage_item.h"
+#include "storage_writer.hpp"
 
 namespace eurora::core {
 
-struct StorageItemTags {
-    std::string subject;
-    std::optional<std::string> device;
-    std::optional<std::string> session;
-    std::optional<std::string> name;
-    std::multimap<std::string, std::string> custom_tags;
-
-    class Builder {
-    public:
-        explicit Builder(std::string_view subject) : tags{.subject = std::string(subject)} {}
-
-        Builder& with_device(std::string_view device) {
-            tags.device = std::string(device);
-            return *this;
-        }
-
-        Builder& with_session(std::string_view session) {
-            tags.session = std::string(session);
-            return *this;
-        }
-
-        Builder& with_name(std::string_view name) {
-            tags.name = std::string(name);
-            return *this;
-        }
-
-        Builder& with_custom_tag(std::string_view tag_name, std::string_view tag_value) {
-            tags.custom_tags.emplace(std::string(tag_name), std::string(tag_value));
-            return *this;
-        }
-
-        StorageItemTags build() const { return tags; }
-
-    private:
-        StorageItemTags tags;
-    };
-};
-
-struct StorageItem {
-    StorageItemTags tags;
-    std::string location;
-    std::string contentType;
-    std::chrono::time_point<std::chrono::system_clock> lastModified;
-    std::optional<std::chrono::time_point<std::chrono::system_clock>> expires;
-    std::string data;
-};
-
-struct StorageItemList {
-    std::vector<StorageItem> items;
-    bool complete = false;
-    std::string continuation;
-};
-
-class StorageClient {
-public:
-    explicit StorageClient(std::string_view base_url) : base_url(std::string(base_url)) {
-        if (base_url.back() == '/') {
-            this->base_url.pop_back();  // Ensure no trailing slash
-        }
-    }
-
-    virtual ~StorageClient() = default;
-
-    virtual StorageItemList list_items(const StorageItemTags& tags, size_t limit = 20);
-    virtual StorageItemList get_next_page_of_items(const StorageItemList& page);
-    virtual std::shared_ptr<std::istream> get_latest_item(const StorageItemTags& tags);
-    virtual std::shared_ptr<std::istream> get_item_by_url(std::string_view url);
-    virtual StorageItem store_item(const StorageItemTags& tags, std::istream& data, std::optional<std::chrono::seconds> ttl = {});
-    virtual std::optional<std::string> health_check();
-
-private:
-    std::string base_url;
-};
-
 class StorageSpace {
 public:
-    StorageSpace(std::shared_ptr<StorageClient> client, IsmrmrdContextVariables context_vars, std::chrono::seconds default_duration)
-        : client(std::move(client)), context_vars(std::move(context_vars)), default_duration(default_duration) {}
+    /// `cache` and `writer` are optional. Spaces of one session should share them, so their writes invalidate and
+    /// settle each other's reads.
+    StorageSpace(std::shared_ptr<StorageClient> client, IsmrmrdContextVariables context_vars, std::chrono::seconds default_duration,
+                 std::shared_ptr<StorageCache> cache = nullptr, std::shared_ptr<StorageWriter> writer = nullptr)
+        : client(std::move(client)),
+          context_vars(std::move(context_vars)),
+          default_duration(default_duration),
+          cache(std::move(cache)),
+          writer(std::move(writer)) {}
 
     virtual ~StorageSpace() = default;
 
@@ -101,29 +44,74 @@ public:
         store(key, value, default_duration);
     }
 
+    /// With a writer the value is copied and stored in the background; later reads through a space still see it.
     template <typename T, typename Rep, typename Period>
     void store(const std::string& key, const T& value, std::chrono::duration<Rep, Period> duration) {
+        EURORA_TRACE_SCOPE("storage", "StorageSpace::store");
+        static auto& latency = storage_latency("store");
+        eurora::utils::LatencyTimer timer(latency);
         auto tags = get_tag_builder(true).with_name(key).build();
-        std::stringstream stream;
-        Core::IO::write(stream, value);
-        client->store_item(tags, stream, std::chrono::duration_cast<std::chrono::seconds>(duration));
+        auto ttl  = std::chrono::duration_cast<std::chrono::seconds>(duration);
+        if (writer) {
+            auto copy = std::make_shared<const T>(value);
+            writer->enqueue(tags, [copy](std::ostream& stream) { io::write(stream, *copy); }, ttl);
+        } else {
+            client->store_item_streamed(tags, [&value](std::ostream& stream) { io::write(stream, value); }, ttl);
+        }
+        if (cache) {
+            cache->invalidate(tags);
+        }
+    }
+
+    /// Waits for queued background writes; a no-op without a writer.
+    void flush() {
+        EURORA_TRACE_SCOPE("storage", "StorageSpace::flush");
+        static auto& latency = storage_latency("flush");
+        eurora::utils::LatencyTimer timer(latency);
+        if (writer) {
+            writer->flush();
+        }
     }
 
 protected:
     virtual StorageItemTags::Builder get_tag_builder(bool for_write) = 0;
 
+    static eurora::utils::Histogram& storage_latency(const char* operation) {
+        return eurora::utils::MetricsRegistry::Instance().GetHistogram("eurora_storage_latency_seconds", "Latency of StorageSpace operations.",
+                                                                       {{"operation", operation}}, 1e-9);
+    }
+
     template <typename T>
     std::optional<T> get_latest(const StorageItemTags& tags) const {
+        EURORA_TRACE_SCOPE("storage", "StorageSpace::get_latest");
+        static auto& latency = storage_latency("get_latest");
+        eurora::utils::LatencyTimer timer(latency);
+        if (cache) {
+            if (auto cached = cache->get<T>(tags)) {
+                return *cached;
+            }
+        }
+
+        const auto epoch = cache ? cache->epoch() : 0;
+        if (writer) {
+            writer->settle(tags);
+        }
         auto data = client->get_latest_item(tags);
-        if (data) {
-            return Core::IO::read<T>(*data);
+        if (!data) {
+            return {};
+        }
+        auto value = io::read<T>(*data);
+        if (cache) {
+            cache->put(tags, value, epoch);
         }
-        return {};
+        return value;
     }
 
     std::shared_ptr<StorageClient> client;
     IsmrmrdContextVariables context_vars;
     std::chrono::seconds default_duration;
+    std::shared_ptr<StorageCache> cache;
+    std::shared_ptr<StorageWriter> writer;
 };
 
 class StorageSpaceWithDefaultRead : public StorageSpace {
@@ -145,12 +133,12 @@ public:
 class SessionSpace : public StorageSpaceWithDefaultRead {
 protected:
     StorageItemTags::Builder get_tag_builder(bool for_write) override {
-        if (context_vars.subject_id().empty()) {
+        if (context_vars.SubjectId().empty()) {
             throw std::runtime_error("Missing subject ID in ISMRMRD header.");
         }
-        auto builder = StorageItemTags::Builder(context_vars.subject_id());
-        if (!context_vars.device_id().empty()) {
-            builder.with_device(context_vars.device_id());
+        auto builder = StorageItemTags::Builder(context_vars.SubjectId());
+        if (!context_vars.DeviceId().empty()) {
+            builder.with_device(context_vars.DeviceId());
         }
         return builder;
     }
@@ -159,15 +147,17 @@ protected:
 class ScannerSpace : public StorageSpaceWithDefaultRead {
 protected:
     StorageItemTags::Builder get_tag_builder(bool for_write) override {
-        if (context_vars.device_id().empty()) {
+        if (context_vars.DeviceId().empty()) {
             throw std::runtime_error("Missing device ID in ISMRMRD header.");
         }
-        return StorageItemTags::Builder("$null").with_device(context_vars.device_id());
+        return StorageItemTags::Builder("$null").with_device(context_vars.DeviceId());
     }
 };
 
 class MeasurementSpace : public StorageSpace {
 public:
+    using StorageSpace::StorageSpace;
+
     template <typename T>
     std::optional<T> get_latest(const std::string& measurement_id, const std::string& key) {
         try {
@@ -181,15 +171,15 @@ public:
 
 protected:
     StorageItemTags::Builder get_tag_builder(bool for_write) override {
-        if (context_vars.subject_id().empty()) {
+        if (context_vars.SubjectId().empty()) {
             throw std::runtime_error("Missing subject ID in ISMRMRD header.");
         }
-        auto builder = StorageItemTags::Builder(context_vars.subject_id());
-        if (for_write && context_vars.measurement_id().empty()) {
+        auto builder = StorageItemTags::Builder(context_vars.SubjectId());
+        if (for_write && context_vars.MeasurementId().empty()) {
             throw std::runtime_error("Missing measurement ID in ISMRMRD header.");
         }
         if (for_write) {
-            builder.with_custom_tag("measurement", context_vars.measurement_id());
+            builder.with_custom_tag("measurement", context_vars.MeasurementId());
         }
         return builder;
     }
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "eurora/utils/logger.h"
+#include "storage_client.h"
+#include "thread_pool.hpp"
+
+namespace eurora::core {
+
+/**
+ * Write-behind queue in front of a StorageClient, so a slow backend does not stall the thread that stores.
+ *
+ * Each write waits `coalesce_window` before a background thread serializes it into the client; storing the same
+ * tags again in the meantime replaces the queued payload instead of adding a second upload. At most `max_pending`
+ * writes are queued, after which enqueue() blocks until the writer catches up.
+ *
+ * Failed writes are logged and counted; nothing is retried. flush() and the destructor wait for everything queued.
+ */
+class StorageWriter {
+    class IdleAwaiter;
+
+public:
+    using Serializer = StorageWriteFunction;
+
+    struct Options {
+        std::size_t max_pending = 64;
+        std::chrono::milliseconds coalesce_window{200};
+    };
+
+    struct Stats {
+        uint64_t enqueued  = 0;
+        uint64_t coalesced = 0;
+        uint64_t written   = 0;
+        uint64_t failed    = 0;
+        uint64_t blocked   = 0;  ///< Enqueues that had to wait for room in the queue.
+        std::size_t pending = 0;
+    };
+
+    explicit StorageWriter(std::shared_ptr<StorageClient> client) : StorageWriter(std::move(client), Options{}) {}
+    StorageWriter(std::shared_ptr<StorageClient> client, Options options);
+    ~StorageWriter();
+
+    StorageWriter(const StorageWriter&)            = delete;
+    StorageWriter& operator=(const StorageWriter&) = delete;
+
+    void enqueue(const StorageItemTags& tags, Serializer serializer, std::optional<std::chrono::seconds> ttl);
+
+    /// Blocks until no queued or running write would be visible to a read with `query`.
+    void settle(const StorageItemTags& query);
+    /// Blocks until every queued write has been attempted.
+    void flush();
+
+    /**
+     * settle() and flush() for coroutines: `co_await writer.async_flush(pool);` suspends instead of blocking a thread
+     * and resumes the coroutine on `pool`, never on the writer thread, which a continuation that enqueues could stall.
+     * `pool` must outlive the writer.
+     */
+    IdleAwaiter async_settle(const StorageItemTags& query, ThreadPool& pool) { return IdleAwaiter(*this, pool, query); }
+    IdleAwaiter async_flush(ThreadPool& pool) { return IdleAwaiter(*this, pool, std::nullopt); }
+
+    Stats stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Pending {
+        StorageItemTags tags;
+        Serializer serializer;
+        std::optional<std::chrono::seconds> ttl;
+        Clock::time_point due;
+    };
+
+    class IdleAwaiter {
+    public:
+        IdleAwaiter(StorageWriter& writer, ThreadPool& pool, std::optional<StorageItemTags> query)
+            : writer_(writer), pool_(pool), query_(std::move(query)) {}
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const noexcept {}
+
+    private:
+        friend class StorageWriter;
+
+        const StorageItemTags* query() const { return query_ ? &*query_ : nullptr; }
+
+        StorageWriter& writer_;
+        ThreadPool& pool_;
+        std::optional<StorageItemTags> query_;
+        std::coroutine_handle<> handle_;
+    };
+
+    bool busy_locked(const StorageItemTags* query) const;
+    void wait_idle(const StorageItemTags* query);
+    // Takes the suspended awaiters whose writes are all done off idle_waiters_.
+    std::vector<IdleAwaiter*> take_idle_waiters_locked();
+    void run();
+
+private:
+    std::shared_ptr<StorageClient> client_;
+    const Options options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+
+    std::deque<std::string> order_;  // Keys of pending_ in arrival order.
+    std::unordered_map<std::string, Pending> pending_;
+    std::optional<StorageItemTags> in_flight_;
+    std::vector<IdleAwaiter*> idle_waiters_;  // Coroutines suspended in async_flush() or async_settle().
+    std::size_t expedite_ = 0;                // Callers waiting in any flush or settle; the window is skipped meanwhile.
+    bool stopping_        = false;
+    Stats stats_;
+
+    std::thread thread_;
+};
+
+/** Implementation **/
+
+inline StorageWriter::StorageWriter(std::shared_ptr<StorageClient> client, Options options)
+    : client_(std::move(client)), options_(options), thread_([this]() { run(); }) {}
+
+inline StorageWriter::~StorageWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    thread_.join();
+}
+
+inline void StorageWriter::enqueue(const StorageItemTags& tags, Serializer serializer, std::optional<std::chrono::seconds> ttl) {
+    auto key = tags.key();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++stats_.enqueued;
+
+    bool blocked = false;
+    while (true) {
+        if (auto it = pending_.find(key); it != pending_.end()) {
+            // Keeps its place and due time, so continuous overwrites still get written out.
+            it->second.serializer = std::move(serializer);
+            it->second.ttl        = ttl;
+            ++stats_.coalesced;
+            return;
+        }
+        if (pending_.size() < options_.max_pending) {
+            break;
+        }
+        if (!std::exchange(blocked, true)) {
+            ++stats_.blocked;
+        }
+        done_cv_.wait(lock);
+    }
+
+    pending_.emplace(key, Pending{tags, std::move(serializer), ttl, Clock::now() + options_.coalesce_window});
+    order_.push_back(std::move(key));
+    work_cv_.notify_one();
+}
+
+inline void StorageWriter::settle(const StorageItemTags& query) { wait_idle(&query); }
+
+inline void StorageWriter::flush() { wait_idle(nullptr); }
+
+inline StorageWriter::Stats StorageWriter::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats   = stats_;
+    stats.pending = pending_.size() + (in_flight_ ? 1 : 0);
+    return stats;
+}
+
+inline bool StorageWriter::busy_locked(const StorageItemTags* query) const {
+    if (!query) {
+        return !pending_.empty() || in_flight_;
+    }
+    if (in_flight_ && query->matches(*in_flight_)) {
+        return true;
+    }
+    for (const auto& [key, write] : pending_) {
+        if (query->matches(write.tags)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void StorageWriter::wait_idle(const StorageItemTags* query) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!busy_locked(query)) {
+        return;
+    }
+
+    ++expedite_;
+    work_cv_.notify_one();
+    done_cv_.wait(lock, [this, query]() { return !busy_locked(query); });
+    --expedite_;
+}
+
+inline bool StorageWriter::IdleAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    std::lock_guard<std::mutex> lock(writer_.mutex_);
+    if (!writer_.busy_locked(query())) {
+        return false;
+    }
+
+    handle_ = handle;
+    writer_.idle_waiters_.push_back(this);
+    ++writer_.expedite_;
+    writer_.work_cv_.notify_one();
+    return true;
+}
+
+inline std::vector<StorageWriter::IdleAwaiter*> StorageWriter::take_idle_waiters_locked() {
+    std::vector<IdleAwaiter*> idle;
+    std::erase_if(idle_waiters_, [this, &idle](IdleAwaiter* waiter) {
+        if (busy_locked(waiter->query())) {
+            return false;
+        }
+        idle.push_back(waiter);
+        --expedite_;
+        return true;
+    });
+    return idle;
+}
+
+inline void StorageWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_cv_.wait(lock, [this]() { return stopping_ || !order_.empty(); });
+        if (order_.empty()) {
+            break;
+        }
+
+        auto due = pending_.at(order_.front()).due;
+        if (!stopping_ && expedite_ == 0 && due > Clock::now()) {
+            work_cv_.wait_until(lock, due, [this]() { return stopping_ || expedite_ > 0; });
+            continue;
+        }
+
+        auto node = pending_.extract(order_.front());
+        order_.pop_front();
+        Pending write = std::move(node.mapped());
+        in_flight_    = write.tags;
+        done_cv_.notify_all();  // Room in the queue for blocked producers.
+
+        lock.unlock();
+        bool ok = true;
+        try {
+            client_->store_item_streamed(write.tags, write.serializer, write.ttl);
+        } catch (const std::exception& e) {
+            ok = false;
+            STREAM_ERROR() << "Write-behind store of '" << write.tags.name.value_or("") << "' for subject " << write.tags.subject << " failed: " << e.what();
+        }
+        lock.lock();
+
+        ++(ok ? stats_.written : stats_.failed);
+        in_flight_.reset();
+        done_cv_.notify_all();
+
+        if (auto idle = take_idle_waiters_locked(); !idle.empty()) {
+            lock.unlock();
+            for (IdleAwaiter* waiter : idle) {
+                try {
+                    waiter->pool_.Resume(waiter->handle_);
+                } catch (const std::exception&) {
+                    // The pool was stopped; resuming here beats leaving the coroutine suspended forever.
+                    waiter->handle_.resume();
+                }
+            }
+            lock.lock();
+        }
+    }
+}
+
+}  // namespace eurora::core
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace eurora::core {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+class TaskPromiseBase {
+public:
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    // Hands control straight to the awaiting coroutine instead of resuming it from a nested call.
+    auto final_suspend() noexcept {
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<>) noexcept { return continuation; }
+            void await_resume() noexcept {}
+
+            std::coroutine_handle<> continuation;
+        };
+        return FinalAwaiter{continuation_};
+    }
+
+    void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+    void SetContinuation(std::coroutine_handle<> continuation) noexcept { continuation_ = continuation; }
+
+protected:
+    void RethrowIfFailed() const {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+    }
+
+private:
+    std::coroutine_handle<> continuation_ = std::noop_coroutine();
+    std::exception_ptr exception_;
+};
+
+template <typename T>
+class TaskPromise : public TaskPromiseBase {
+public:
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& value) {
+        value_.emplace(std::forward<U>(value));
+    }
+
+    T Result() {
+        this->RethrowIfFailed();
+        return std::move(*value_);
+    }
+
+private:
+    std::optional<T> value_;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase {
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+
+    void Result() { this->RethrowIfFailed(); }
+};
+
+}  // namespace detail
+
+/**
+ * Coroutine returning a T, started when it is first awaited.
+ *
+ * A Task suspends instead of blocking, e.g. on `co_await pool.Schedule()` or `co_await pool.Submit(...)`, so
+ * thousands of pipeline stages can be in flight on a handful of ThreadPool workers. Await it from another Task, or
+ * hand it to Spawn() to start it from ordinary code.
+ */
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    Task(const Task&)            = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            bool await_ready() noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().SetContinuation(awaiting);
+                return handle;
+            }
+
+            T await_resume() { return handle.promise().Result(); }
+
+            std::coroutine_handle<promise_type> handle;
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    friend promise_type;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+// Coroutine owning itself: runs eagerly and frees its frame when it finishes.
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+template <typename T>
+DetachedTask RunDetached(Task<T> task, std::promise<T> promise) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(task);
+            promise.set_value();
+        } else {
+            promise.set_value(co_await std::move(task));
+        }
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Starts `task` on the calling thread; it runs there until its first suspension and wherever it is resumed after.
+ * The future is ready when the task has finished and holds its result or exception; dropping it does not block.
+ */
+template <typename T>
+std::future<T> Spawn(Task<T> task) {
+    std::promise<T> promise;
+    auto result = promise.get_future();
+    detail::RunDetached(std::move(task), std::move(promise));
+    return result;
+}
+
+}  // namespace eurora::core
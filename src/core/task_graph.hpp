@@ -0,0 +1,165 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+namespace eurora::core {
+
+/**
+ * Tasks with dependencies, run on a ThreadPool without ever blocking a worker on a future.
+ *
+ * Nodes name their predecessors when they are added, e.g. coil combination after the coil maps and GRAPPA
+ * calibration after the prewhitener, so the graph is acyclic by construction. Run() pushes the nodes without
+ * predecessors; whichever worker finishes the last predecessor of a node releases it, running one released node
+ * itself and pushing the others. The graph is only a description: it can be run again for every repetition, even
+ * while earlier runs are still in flight, but must outlive its runs and must not be changed while they are.
+ */
+class TaskGraph {
+public:
+    using NodeId = std::size_t;
+
+    TaskGraph() = default;
+
+    TaskGraph(const TaskGraph&)            = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    /// Adds a node that runs after all of `predecessors`, which must have been added before.
+    NodeId Add(std::function<void()> work, const std::vector<NodeId>& predecessors = {}, const TaskSchedule& schedule = {});
+
+    std::size_t Size() const { return nodes_.size(); }
+
+    /**
+     * Runs every node once on `pool`. The future becomes ready when all nodes are done; if one throws, the nodes
+     * that have not started yet are skipped and the future rethrows the first exception.
+     */
+    std::future<void> Run(ThreadPool& pool) const;
+
+private:
+    struct Node {
+        std::function<void()> work;
+        TaskSchedule schedule;
+        std::vector<NodeId> successors;
+        std::size_t num_predecessors = 0;
+    };
+
+    struct RunState {
+        RunState(const TaskGraph& owner, ThreadPool& executor);
+
+        const TaskGraph& graph;
+        ThreadPool& pool;
+        std::unique_ptr<std::atomic<std::size_t>[]> waiting;  // Unfinished predecessors per node.
+        std::atomic<std::size_t> remaining;                   // Unfinished nodes.
+        std::atomic<bool> failed{false};
+        std::mutex error_mutex;
+        std::exception_ptr error;
+        std::promise<void> done;
+    };
+
+    static void Execute(const std::shared_ptr<RunState>& state, NodeId id);
+    static void Release(const std::shared_ptr<RunState>& state, NodeId id);
+
+private:
+    std::vector<Node> nodes_;
+};
+
+/** Implementation **/
+
+inline TaskGraph::RunState::RunState(const TaskGraph& owner, ThreadPool& executor)
+    : graph(owner), pool(executor), waiting(new std::atomic<std::size_t>[owner.nodes_.size()]), remaining(owner.nodes_.size()) {
+    for (std::size_t i = 0; i < owner.nodes_.size(); ++i) {
+        waiting[i].store(owner.nodes_[i].num_predecessors, std::memory_order_relaxed);
+    }
+}
+
+inline TaskGraph::NodeId TaskGraph::Add(std::function<void()> work, const std::vector<NodeId>& predecessors, const TaskSchedule& schedule) {
+    for (NodeId predecessor : predecessors) {
+        if (predecessor >= nodes_.size()) {
+            throw std::invalid_argument("TaskGraph predecessor " + std::to_string(predecessor) + " has not been added");
+        }
+    }
+
+    const NodeId id = nodes_.size();
+    nodes_.push_back({std::move(work), schedule, {}, predecessors.size()});
+    for (NodeId predecessor : predecessors) {
+        nodes_[predecessor].successors.push_back(id);
+    }
+    return id;
+}
+
+inline std::future<void> TaskGraph::Run(ThreadPool& pool) const {
+    auto state  = std::make_shared<RunState>(*this, pool);
+    auto result = state->done.get_future();
+    if (nodes_.empty()) {
+        state->done.set_value();
+        return result;
+    }
+
+    for (NodeId id = 0; id < nodes_.size(); ++id) {
+        if (nodes_[id].num_predecessors == 0) {
+            pool.PushScheduled(nodes_[id].schedule, [state, id]() { Execute(state, id); });
+        }
+    }
+    return result;
+}
+
+inline void TaskGraph::Execute(const std::shared_ptr<RunState>& state, NodeId id) {
+    std::optional<NodeId> current = id;
+    while (current) {
+        const Node& node = state->graph.nodes_[*current];
+        if (!state->failed.load(std::memory_order_acquire)) {
+            try {
+                node.work();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->error_mutex);
+                if (!state->error) {
+                    state->error = std::current_exception();
+                }
+                state->failed.store(true, std::memory_order_release);
+            }
+        }
+
+        // Continue with the first released successor on this worker; it would only wait in the queue otherwise.
+        std::optional<NodeId> next;
+        for (NodeId successor : node.successors) {
+            if (state->waiting[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                if (next) {
+                    Release(state, successor);
+                } else {
+                    next = successor;
+                }
+            }
+        }
+
+        if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(state->error_mutex);
+            if (state->error) {
+                state->done.set_exception(state->error);
+            } else {
+                state->done.set_value();
+            }
+        }
+        current = next;
+    }
+}
+
+inline void TaskGraph::Release(const std::shared_ptr<RunState>& state, NodeId id) {
+    try {
+        state->pool.PushScheduled(state->graph.nodes_[id].schedule, [state, id]() { Execute(state, id); });
+    } catch (const std::runtime_error&) {
+        // The pool was stopped mid-run; finish here rather than leaving the run hanging.
+        Execute(state, id);
+    }
+}
+
+}  // namespace eurora::core
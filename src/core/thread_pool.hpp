@@ -1,24 +1,105 @@
+#pragma once
+
 #include <atomic>
+#include <coroutine>
 #include <functional>
 #include <future>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <string>
 #include <thread>
 #include <vector>
 
-#include "thread_safe_queue.hpp"
+#include "eurora/utils/metrics.h"
+#include "eurora/utils/resource_usage.h"
+#include "eurora/utils/trace.h"
+#include "numa.hpp"
+#include "priority_task_queue.hpp"
+#include "task.hpp"
 
 namespace eurora::core {
+
+/**
+ * Fixed set of worker threads running pushed tasks.
+ *
+ * Workers can be split into groups, each with its own queue and optionally pinned to a set of CPUs. With one group
+ * per NUMA node (see NumaGroups()), PushToNode() and PushNear() run a task on the socket that owns its data instead
+ * of letting it pull that data across the interconnect.
+ *
+ * Each group runs its queued tasks earliest due first (see PriorityTaskQueue), so PushScheduled() lets interactive
+ * work overtake queued batch work. Running tasks are never interrupted; a worker picks the next task when it is done.
+ *
+ * Coroutines use the pool through Schedule() and Submit() instead of futures, see Task.
+ */
 class ThreadPool {
 public:
-    explicit ThreadPool(size_t num_threads) : stop_(false) {
-        for (size_t i = 0; i < num_threads; ++i) {
-            workers_.emplace_back([this]() {
-                try {
-                    while (true) {
-                        tasks_.Pop()();
+    struct WorkerGroup {
+        size_t num_threads;
+        std::vector<int> cpus;  // The group's workers may only run on these CPUs; empty leaves them unpinned.
+        int node = -1;          // NUMA node the group serves, -1 for none.
+    };
+
+    /// One group per NUMA node, pinned to the node's CPUs, with `threads_per_node` workers or one per CPU if 0.
+    static std::vector<WorkerGroup> NumaGroups(size_t threads_per_node = 0) {
+        std::vector<WorkerGroup> groups;
+        for (auto& node : numa::Nodes()) {
+            const size_t threads = threads_per_node == 0 ? node.cpus.size() : threads_per_node;
+            groups.push_back({threads, std::move(node.cpus), node.id});
+        }
+        return groups;
+    }
+
+    /// `name` labels the pool's metrics: eurora_queue_depth, eurora_thread_pool_{workers,busy_workers,tasks_total}.
+    explicit ThreadPool(size_t num_threads, std::string name = "thread_pool") : ThreadPool(std::vector<WorkerGroup>{{num_threads, {}, -1}}, std::move(name)) {}
+
+    explicit ThreadPool(std::vector<WorkerGroup> groups, std::string name = "thread_pool")
+        : stop_(false),
+          tasks_completed_(eurora::utils::MetricsRegistry::Instance().GetCounter("eurora_thread_pool_tasks_total", "Tasks run by a thread pool.",
+                                                                                 {{"pool", name}})) {
+        if (groups.empty()) {
+            groups.push_back({0, {}, -1});
+        }
+
+        size_t num_threads = 0;
+        for (const auto& group : groups) {
+            num_threads += group.num_threads;
+            groups_.push_back(std::make_unique<Group>(group.node));
+            if (group.node >= 0) {
+                by_node_[group.node].push_back(groups_.back().get());
+            }
+        }
+
+        auto& registry = eurora::utils::MetricsRegistry::Instance();
+        for (const auto& group : groups_) {
+            metrics_.push_back(eurora::utils::WatchQueueDepth(name, group->tasks));
+        }
+        metrics_.push_back(registry.AddGaugeCallback("eurora_thread_pool_workers", "Worker threads of a thread pool.", {{"pool", name}},
+                                                     [num_threads]() { return static_cast<double>(num_threads); }));
+        metrics_.push_back(registry.AddGaugeCallback("eurora_thread_pool_busy_workers", "Workers of a thread pool running a task.", {{"pool", name}},
+                                                     [this]() { return static_cast<double>(busy_.load(std::memory_order_relaxed)); }));
+
+        for (size_t g = 0; g < groups.size(); ++g) {
+            for (size_t i = 0; i < groups[g].num_threads; ++i) {
+                workers_.emplace_back([this, &queue = groups_[g]->tasks, cpus = groups[g].cpus]() {
+                    if (!cpus.empty()) {
+                        numa::PinCurrentThread(cpus);
                     }
-                } catch (const QueueClosed&) {}
-            });
+                    eurora::utils::Tracer::Instance().SetThreadName("ThreadPool worker");
+                    try {
+                        while (true) {
+                            auto task = queue.Pop();
+                            busy_.fetch_add(1, std::memory_order_relaxed);
+                            {
+                                EURORA_TRACE_SCOPE("pool", "ThreadPool::task");
+                                task();
+                            }
+                            busy_.fetch_sub(1, std::memory_order_relaxed);
+                            tasks_completed_.Increment();
+                        }
+                    } catch (const QueueClosed&) {}
+                });
+            }
         }
     }
 
@@ -30,25 +111,75 @@ public:
     ThreadPool(ThreadPool&&)            = delete;
     ThreadPool& operator=(ThreadPool&&) = delete;
 
+    /// Runs the task on the next group in turn.
     template <typename F, typename... Args>
     auto Push(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
-        using ReturnType = std::invoke_result_t<F, Args...>;
+        return PushToGroup(NextGroup(), TaskSchedule{}, std::forward<F>(f), std::forward<Args>(args)...);
+    }
 
-        auto task = std::make_shared<std::packaged_task<ReturnType()>>(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    /// Like Push(), but ordered within the group's queue by `schedule` instead of arrival.
+    template <typename F, typename... Args>
+    auto PushScheduled(const TaskSchedule& schedule, F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
+        return PushToGroup(NextGroup(), schedule, std::forward<F>(f), std::forward<Args>(args)...);
+    }
 
-        auto result = task->get_future();
-        {
-            if (stop_.load()) {
-                throw std::runtime_error("Cannot push task on a stopped ThreadPool");
-            }
-            tasks_.Push([task]() { (*task)(); });
+    /// Awaitable that suspends the awaiting coroutine and resumes it on a worker: `co_await pool.Schedule();`.
+    auto Schedule(const TaskSchedule& schedule = {}) {
+        struct Awaiter {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { pool.Resume(handle, schedule); }
+            void await_resume() const noexcept {}
+
+            ThreadPool& pool;
+            TaskSchedule schedule;
+        };
+        return Awaiter{*this, schedule};
+    }
+
+    /**
+     * Queues `handle` to be resumed on a worker, for awaitables whose completing thread must not run the coroutine
+     * itself, see StorageWriter::async_flush(). A suspended coroutine costs one small queue entry, no packaged task or future.
+     */
+    void Resume(std::coroutine_handle<> handle, const TaskSchedule& schedule = {}) {
+        if (stop_.load()) {
+            throw std::runtime_error("Cannot resume a coroutine on a stopped ThreadPool");
         }
-        return result;
+        NextGroup().tasks.Push(
+            [handle, account = eurora::utils::ResourceAccount::Current()]() {
+                if (account == nullptr) {
+                    handle.resume();
+                    return;
+                }
+                eurora::utils::ResourceScope scope(account);
+                handle.resume();
+            },
+            schedule);
+    }
+
+    /// Runs `f(args...)` on a worker; the awaiting coroutine continues there with the result and blocks no thread meanwhile.
+    template <typename F, typename... Args>
+    Task<std::invoke_result_t<F, Args...>> Submit(F f, Args... args) {
+        co_await Schedule();
+        co_return std::invoke(std::move(f), std::move(args)...);
+    }
+
+    /// Runs the task on a group serving NUMA node `node`; on any group, like Push(), if none does.
+    template <typename F, typename... Args>
+    auto PushToNode(int node, F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
+        return PushToGroup(GroupForNode(node), TaskSchedule{}, std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    /// Runs the task on the node that holds the memory at `address`, e.g. the k-space buffer of the slice it processes.
+    template <typename F, typename... Args>
+    auto PushNear(const void* address, F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
+        return PushToNode(numa::NodeOfAddress(address).value_or(-1), std::forward<F>(f), std::forward<Args>(args)...);
     }
 
     void Stop() {
         if (!stop_.exchange(true)) {
-            tasks_.Close();
+            for (auto& group : groups_) {
+                group->tasks.Close();
+            }
 
             for (std::thread& worker : workers_) {
                 if (worker.joinable()) {
@@ -58,10 +189,61 @@ public:
         }
     }
 
+private:
+    struct Group {
+        explicit Group(int numa_node) : node(numa_node) {}
+
+        const int node;
+        std::atomic<size_t> next{0};  // Round robin among the groups of a node, kept by the node's first group.
+        PriorityTaskQueue<std::function<void()>> tasks;
+    };
+
+    template <typename F, typename... Args>
+    auto PushToGroup(Group& group, const TaskSchedule& schedule, F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
+        using ReturnType = std::invoke_result_t<F, Args...>;
+
+        // The task is charged to the resource account of whoever pushed it, which has to outlive the task. The scope
+        // ends inside the packaged task, so the charges are in before the future becomes ready.
+        auto task = std::make_shared<std::packaged_task<ReturnType()>>(
+            [account = eurora::utils::ResourceAccount::Current(), call = std::bind(std::forward<F>(f), std::forward<Args>(args)...)]() mutable -> ReturnType {
+                if (account == nullptr) {
+                    return call();
+                }
+                eurora::utils::ResourceScope scope(account);
+                return call();
+            });
+
+        auto result = task->get_future();
+        {
+            if (stop_.load()) {
+                throw std::runtime_error("Cannot push task on a stopped ThreadPool");
+            }
+            group.tasks.Push([task]() { (*task)(); }, schedule);
+        }
+        return result;
+    }
+
+    Group& NextGroup() { return *groups_[next_group_.fetch_add(1, std::memory_order_relaxed) % groups_.size()]; }
+
+    Group& GroupForNode(int node) {
+        auto it = by_node_.find(node);
+        if (it == by_node_.end()) {
+            return NextGroup();
+        }
+        const auto& groups = it->second;
+        return *groups[groups.front()->next.fetch_add(1, std::memory_order_relaxed) % groups.size()];
+    }
+
 private:
     std::vector<std::thread> workers_;
-    ThreadSafeQueue<std::function<void()>> tasks_;
+    std::vector<std::unique_ptr<Group>> groups_;
+    std::map<int, std::vector<Group*>> by_node_;
+    std::atomic<size_t> next_group_{0};
     std::atomic<bool> stop_;
+
+    std::atomic<size_t> busy_{0};
+    eurora::utils::Counter& tasks_completed_;
+    std::vector<eurora::utils::GaugeCallback> metrics_;  // Declared last: unregistered before what they read goes away.
 };
 
 }  // namespace eurora::core
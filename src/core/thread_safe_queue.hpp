@@ -1,7 +1,18 @@
+#pragma once
+
+#include <chrono>
 #include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <iterator>
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <ranges>
+#include <stop_token>
+#include <utility>
+#include <vector>
 
 #include "eurora/utils/exception.hpp"
 
@@ -10,6 +21,8 @@ EURORA_DEFINE_EXCEPTION(QueueClosed)
 namespace eurora::core {
 template <typename T>
 class ThreadSafeQueue {
+    class PopAwaiter;
+
 public:
     ThreadSafeQueue()  = default;
     ~ThreadSafeQueue() = default;
@@ -22,10 +35,47 @@ public:
 
     void Push(T);
 
+    /// Moves every element of `items` into the queue under one lock acquisition and wakes consumers with one notify.
+    template <std::ranges::input_range Range>
+    void PushBulk(Range&& items);
+
     T Pop();
 
+    /**
+     * Waits for at least one element, then moves up to `max` of them to `out` under one lock acquisition and returns
+     * how many it moved. Throws QueueClosed, like Pop(), once the queue is closed and drained.
+     */
+    template <std::output_iterator<T> OutputIt>
+    size_t PopBulk(OutputIt out, size_t max);
+
+    /**
+     * Pop() that gives up: returns an empty optional once `token` is cancelled, even with elements left, so one
+     * consumer can be shut down without closing the queue for everyone else.
+     */
+    std::optional<T> Pop(std::stop_token token);
+
+    /// Pop() that also gives up at `deadline`; e.g. to flush a partial batch when its time window closes.
+    std::optional<T> PopUntil(std::chrono::steady_clock::time_point deadline, std::stop_token token = {});
+
+    template <class Rep, class Period>
+    std::optional<T> PopFor(std::chrono::duration<Rep, Period> timeout, std::stop_token token = {}) {
+        return PopUntil(std::chrono::steady_clock::now() + timeout, std::move(token));
+    }
+
+    /// PopBulk() that returns 0 at `deadline` or once `token` is cancelled.
+    template <std::output_iterator<T> OutputIt>
+    size_t PopBulkUntil(OutputIt out, size_t max, std::chrono::steady_clock::time_point deadline, std::stop_token token = {});
+
     std::optional<T> TryPop();
 
+    /**
+     * Pop() for coroutines: `T message = co_await queue.AsyncPop();` suspends instead of blocking a thread while the
+     * queue is empty, and throws QueueClosed like Pop(). The Push() that provides the element, or Close(), resumes the
+     * coroutine on its own thread once the lock is released; `co_await pool.Schedule()` moves it on from there.
+     * Suspended pops are served before blocked ones and must be resumed by Close() before the queue is destroyed.
+     */
+    PopAwaiter AsyncPop() { return PopAwaiter(*this); }
+
     void Close();
 
     bool Empty() const;
@@ -33,12 +83,50 @@ public:
     size_t Size() const;
 
 private:
+    class PopAwaiter {
+    public:
+        explicit PopAwaiter(ThreadSafeQueue& queue) : queue_(queue) {}
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle);
+        T await_resume();
+
+    private:
+        friend class ThreadSafeQueue;
+
+        ThreadSafeQueue& queue_;
+        std::coroutine_handle<> handle_;
+        std::optional<T> message_;
+    };
+
+    // Hands `message` straight to the longest suspended AsyncPop() if there is one, else queues it. Returns the
+    // coroutine to resume once the lock is released, or a null handle if a blocked Pop() needs a notify instead.
+    std::coroutine_handle<> DeliverLocked(T message);
+
     T PopImpl(std::unique_lock<std::mutex> lock);
 
+    template <std::output_iterator<T> OutputIt>
+    size_t PopBulkImpl(OutputIt out, size_t max, const std::optional<std::chrono::steady_clock::time_point>& deadline,
+                       const std::stop_token& token);
+
+    // Waits, without polling, for an element, the deadline if there is one, or cancellation. Returns whether an
+    // element is ready; throws QueueClosed when the queue is closed and drained. Call it with `wake` registered.
+    bool WaitReady(std::unique_lock<std::mutex>& lock, const std::optional<std::chrono::steady_clock::time_point>& deadline,
+                   const std::stop_token& token);
+
+    // Registered before the lock is taken: it runs on the cancelling thread and needs the mutex to notify.
+    auto WakeOnStop(const std::stop_token& token) {
+        return std::stop_callback(token, [this]() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            condition_.notify_all();
+        });
+    }
+
 private:
     mutable std::mutex mutex_;
     std::condition_variable condition_;
     std::queue<T> queue_;
+    std::deque<PopAwaiter*> waiters_;  // Suspended AsyncPop() calls, only ever waiting on an empty queue.
     bool closed_ = false;
 };
 
@@ -53,15 +141,135 @@ T ThreadSafeQueue<T>::PopImpl(std::unique_lock<std::mutex> lock) {
     return message;
 }
 
+template <class T>
+std::coroutine_handle<> ThreadSafeQueue<T>::DeliverLocked(T message) {
+    if (waiters_.empty()) {
+        queue_.push(std::move(message));
+        return nullptr;
+    }
+    PopAwaiter* waiter = waiters_.front();
+    waiters_.pop_front();
+    waiter->message_.emplace(std::move(message));
+    return waiter->handle_;
+}
+
 template <class T>
 void ThreadSafeQueue<T>::Push(T message) {
+    std::coroutine_handle<> waiter;
     {
         std::lock_guard<std::mutex> lock(mutex_);
         if (closed_)
             throw QueueClosed();
-        queue_.push(std::move(message));
+        waiter = DeliverLocked(std::move(message));
+    }
+    if (waiter) {
+        waiter.resume();
+    } else {
+        condition_.notify_one();
+    }
+}
+
+template <class T>
+template <std::ranges::input_range Range>
+void ThreadSafeQueue<T>::PushBulk(Range&& items) {
+    std::vector<std::coroutine_handle<>> resumed;
+    size_t count = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_)
+            throw QueueClosed();
+        for (auto&& item : items) {
+            if (auto waiter = DeliverLocked(std::move(item))) {
+                resumed.push_back(waiter);
+            } else {
+                ++count;
+            }
+        }
+    }
+    if (count == 1) {
+        condition_.notify_one();
+    } else if (count > 1) {
+        condition_.notify_all();
+    }
+    for (auto waiter : resumed) {
+        waiter.resume();
+    }
+}
+
+template <class T>
+template <std::output_iterator<T> OutputIt>
+size_t ThreadSafeQueue<T>::PopBulk(OutputIt out, size_t max) {
+    return PopBulkImpl(out, max, std::nullopt, {});
+}
+
+template <class T>
+template <std::output_iterator<T> OutputIt>
+size_t ThreadSafeQueue<T>::PopBulkImpl(OutputIt out, size_t max, const std::optional<std::chrono::steady_clock::time_point>& deadline,
+                                       const std::stop_token& token) {
+    if (max == 0) {
+        return 0;
     }
-    condition_.notify_one();
+    auto wake = WakeOnStop(token);
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!WaitReady(lock, deadline, token)) {
+        return 0;
+    }
+    size_t count = 0;
+    for (; count < max && !queue_.empty(); ++count) {
+        *out++ = std::move(queue_.front());
+        queue_.pop();
+    }
+    return count;
+}
+
+template <class T>
+bool ThreadSafeQueue<T>::WaitReady(std::unique_lock<std::mutex>& lock, const std::optional<std::chrono::steady_clock::time_point>& deadline,
+                                   const std::stop_token& token) {
+    auto ready = [this, &token]() { return !this->queue_.empty() || closed_ || token.stop_requested(); };
+    if (deadline) {
+        if (!condition_.wait_until(lock, *deadline, ready)) {
+            return false;
+        }
+    } else {
+        condition_.wait(lock, ready);
+    }
+    if (token.stop_requested()) {
+        return false;
+    }
+    if (queue_.empty()) {
+        throw QueueClosed();
+    }
+    return true;
+}
+
+template <class T>
+std::optional<T> ThreadSafeQueue<T>::Pop(std::stop_token token) {
+    auto wake = WakeOnStop(token);
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!WaitReady(lock, std::nullopt, token)) {
+        return std::nullopt;
+    }
+    T message = std::move(queue_.front());
+    queue_.pop();
+    return message;
+}
+
+template <class T>
+std::optional<T> ThreadSafeQueue<T>::PopUntil(std::chrono::steady_clock::time_point deadline, std::stop_token token) {
+    auto wake = WakeOnStop(token);
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!WaitReady(lock, deadline, token)) {
+        return std::nullopt;
+    }
+    T message = std::move(queue_.front());
+    queue_.pop();
+    return message;
+}
+
+template <class T>
+template <std::output_iterator<T> OutputIt>
+size_t ThreadSafeQueue<T>::PopBulkUntil(OutputIt out, size_t max, std::chrono::steady_clock::time_point deadline, std::stop_token token) {
+    return PopBulkImpl(out, max, deadline, token);
 }
 
 template <class T>
@@ -79,13 +287,42 @@ std::optional<T> ThreadSafeQueue<T>::TryPop() {
     return PopImpl(std::move(lock));
 }
 
+template <class T>
+bool ThreadSafeQueue<T>::PopAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    std::lock_guard<std::mutex> lock(queue_.mutex_);
+    if (!queue_.queue_.empty()) {
+        message_.emplace(std::move(queue_.queue_.front()));
+        queue_.queue_.pop();
+        return false;
+    }
+    if (queue_.closed_) {
+        return false;
+    }
+    handle_ = handle;
+    queue_.waiters_.push_back(this);
+    return true;
+}
+
+template <class T>
+T ThreadSafeQueue<T>::PopAwaiter::await_resume() {
+    if (!message_) {
+        throw QueueClosed();
+    }
+    return std::move(*message_);
+}
+
 template <class T>
 void ThreadSafeQueue<T>::Close() {
+    std::deque<PopAwaiter*> waiters;
     {
         std::lock_guard<std::mutex> lock(mutex_);
         closed_ = true;
+        waiters.swap(waiters_);
     }
     condition_.notify_all();
+    for (PopAwaiter* waiter : waiters) {
+        waiter->handle_.resume();
+    }
 }
 
 template <class T>
@@ -0,0 +1,154 @@
+#include "async_log_frontend.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <string>
+
+namespace eurora::utils {
+
+namespace {
+
+// How long the formatting thread sleeps when every ring is empty. Producers never signal it, which keeps them lock free.
+constexpr auto kIdleWait = std::chrono::milliseconds(2);
+
+std::atomic<std::uint64_t> next_frontend_id{1};
+
+}  // namespace
+
+struct AsyncLogFrontend::Ring {
+    explicit Ring(std::size_t bytes) : ring(bytes) {}
+
+    LogRing ring;
+    std::atomic<bool> orphaned{false};  // Set when the owning thread exits.
+};
+
+struct AsyncLogFrontend::ThreadRingHandle {
+    ~ThreadRingHandle() {
+        if (ring) {
+            ring->orphaned.store(true, std::memory_order_release);
+        }
+    }
+
+    std::uint64_t frontend_id = 0;
+    std::shared_ptr<Ring> ring;
+};
+
+AsyncLogFrontend::AsyncLogFrontend(LoggerImpl& impl, std::size_t ring_bytes)
+    : impl_(impl), ring_bytes_(ring_bytes), id_(next_frontend_id.fetch_add(1)), thread_([this]() { Run(); }) {}
+
+AsyncLogFrontend::~AsyncLogFrontend() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+LogRing* AsyncLogFrontend::ThreadRing() {
+    thread_local ThreadRingHandle handle;
+    if (handle.frontend_id != id_) {
+        if (handle.ring) {
+            handle.ring->orphaned.store(true, std::memory_order_release);
+        }
+        handle.ring        = std::make_shared<Ring>(ring_bytes_);
+        handle.frontend_id = id_;
+
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings_.push_back(handle.ring);
+    }
+    return &handle.ring->ring;
+}
+
+void AsyncLogFrontend::Flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const std::uint64_t ticket = ++flush_requested_;
+    wake_.notify_one();
+    flushed_.wait(lock, [&]() { return flush_completed_ >= ticket; });
+}
+
+void AsyncLogFrontend::Run() {
+    while (true) {
+        std::uint64_t requested;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            requested = flush_requested_;
+        }
+
+        if (DrainAll()) {
+            continue;
+        }
+
+        // An empty pass means everything committed before `requested` was taken has been written.
+        std::unique_lock<std::mutex> lock(mutex_);
+        flush_completed_ = requested;
+        flushed_.notify_all();
+        if (stop_) {
+            break;
+        }
+        wake_.wait_for(lock, kIdleWait, [&]() { return stop_ || flush_requested_ != requested; });
+    }
+}
+
+bool AsyncLogFrontend::DrainAll() {
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings = rings_;
+    }
+
+    struct Entry {
+        LogRecord record;
+        std::string message;
+    };
+    std::vector<Entry> entries;
+
+    for (const auto& ring : rings) {
+        const bool orphaned = ring->orphaned.load(std::memory_order_acquire);
+        ring->ring.Drain([&entries](const std::byte* data, std::size_t) {
+            Entry entry;
+            std::memcpy(&entry.record, data, sizeof(LogRecord));
+            try {
+                entry.message = entry.record.format(entry.record.format_string, data + sizeof(LogRecord));
+            } catch (const std::exception& e) {
+                entry.message = std::format("failed to format \"{}\": {}", entry.record.format_string, e.what());
+            }
+            entries.push_back(std::move(entry));
+        });
+
+        if (orphaned) {
+            std::lock_guard<std::mutex> lock(rings_mutex_);
+            std::erase(rings_, ring);
+        }
+    }
+
+    // Records from different threads interleave by the time they were logged, not by ring.
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.record.timestamp_ns < b.record.timestamp_ns; });
+
+    for (const auto& entry : entries) {
+        const auto& record = entry.record;
+        const std::chrono::system_clock::time_point time(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(record.timestamp_ns)));
+        try {
+            impl_.LogAt(time, record.file, record.line, record.function, record.level, entry.message);
+        } catch (const std::exception&) {
+            // The backend is not initialized; there is nowhere to report this.
+        }
+    }
+
+    const std::uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != reported_dropped_) {
+        try {
+            impl_.Log(FileBasename(__FILE__), __LINE__, __FUNCTION__, LogLevel::Warn,
+                      std::format("{} log records dropped because a thread's log ring was full", dropped - reported_dropped_));
+        } catch (const std::exception&) {
+        }
+        reported_dropped_ = dropped;
+    }
+
+    return !entries.empty();
+}
+
+}  // namespace eurora::utils
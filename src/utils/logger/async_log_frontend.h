@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "eurora/utils/async_log.h"
+#include "logger_impl.h"
+
+namespace eurora::utils {
+
+/**
+ * Owns the per-thread rings behind Logger's asynchronous path and the thread that formats their records.
+ *
+ * Rings are created on a thread's first asynchronous statement and released once the thread has exited and its
+ * records are written. Records are handed to the backend in timestamp order within each pass over the rings.
+ */
+class AsyncLogFrontend {
+public:
+    AsyncLogFrontend(LoggerImpl& impl, std::size_t ring_bytes);
+
+    ~AsyncLogFrontend();
+
+    AsyncLogFrontend(const AsyncLogFrontend&)            = delete;
+    AsyncLogFrontend& operator=(const AsyncLogFrontend&) = delete;
+
+    /// The calling thread's ring, registered on first use.
+    LogRing* ThreadRing();
+
+    /// Blocks until every record committed before the call has reached the backend.
+    void Flush();
+
+    void CountDropped() { dropped_.fetch_add(1, std::memory_order_relaxed); }
+
+    std::uint64_t Dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Ring;
+    struct ThreadRingHandle;
+
+    void Run();
+
+    bool DrainAll();
+
+private:
+    LoggerImpl& impl_;
+    const std::size_t ring_bytes_;
+    const std::uint64_t id_;  // Tells a thread's cached ring apart from one registered with an earlier front end.
+
+    std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<Ring>> rings_;
+
+    std::atomic<std::uint64_t> dropped_{0};
+    std::uint64_t reported_dropped_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable flushed_;
+    std::uint64_t flush_requested_ = 0;
+    std::uint64_t flush_completed_ = 0;
+    bool stop_                     = false;
+
+    std::thread thread_;
+};
+
+}  // namespace eurora::utils
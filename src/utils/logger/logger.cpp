@@ -1,25 +1,159 @@
 #include "eurora/utils/logger.h"
 
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <optional>
+
+#include <nlohmann/json.hpp>
+
+#include "async_log_frontend.h"
 #include "logger_impl_spdlog.h"
 
 namespace eurora::utils {
 
+namespace {
+
+std::optional<LogLevel> ParseLevel(const std::string& name) {
+    // The names spdlog accepts for "log_level", plus the LogLevel spellings.
+    static const std::map<std::string, LogLevel, std::less<>> kLevels = {
+        {"trace", LogLevel::Trace}, {"debug", LogLevel::Debug}, {"info", LogLevel::Info},         {"warn", LogLevel::Warn},   {"warning", LogLevel::Warn},
+        {"err", LogLevel::Error},   {"error", LogLevel::Error}, {"critical", LogLevel::Fatal}, {"fatal", LogLevel::Fatal},
+    };
+    auto it = kLevels.find(name);
+    return it == kLevels.end() ? std::nullopt : std::optional<LogLevel>(it->second);
+}
+
+/// The optional "module_levels" object of the config, e.g. {"core": "trace"}.
+std::map<std::string, LogLevel> ReadModuleLevels(const std::string& config_file) {
+    std::map<std::string, LogLevel> levels;
+    std::ifstream file(config_file);
+    auto config = nlohmann::json::parse(file, nullptr, false);
+    if (config.is_discarded() || !config.contains("module_levels") || !config["module_levels"].is_object()) {
+        return levels;
+    }
+    for (const auto& [module, value] : config["module_levels"].items()) {
+        if (auto level = value.is_string() ? ParseLevel(value.get<std::string>()) : std::nullopt) {
+            levels[module] = *level;
+        }
+    }
+    return levels;
+}
+
+}  // namespace
+
 Logger::Logger(Token) : impl_(std::make_unique<LoggerImplSpdlog>()) {}
 
 Logger::~Logger() { Shutdown(); }
 
-bool Logger::InitFromConfig(const std::string& config_file) { return impl_->InitFromConfig(config_file); }
+bool Logger::InitFromConfig(const std::string& config_file) {
+    if (!impl_->InitFromConfig(config_file)) {
+        return false;
+    }
+    initialized_ = true;
+
+    std::lock_guard<std::mutex> lock(modules_mutex_);
+    default_module_.level_.store(impl_->GetLevel(), std::memory_order_relaxed);
+    for (const auto& [name, level] : ReadModuleLevels(config_file)) {
+        auto& module = FindOrAddModule(name);
+        module.overridden_ = true;
+        module.level_.store(level, std::memory_order_relaxed);
+    }
+    ApplyLevels();
+    return true;
+}
 
 void Logger::Log(const char* file, int line, const char* function, LogLevel level, const std::string& message) {
     impl_->Log(file, line, function, level, message);
 }
 
-void Logger::Shutdown() { impl_->Shutdown(); }
+void Logger::Shutdown() {
+    DisableAsync();
+    impl_->Shutdown();
+    initialized_ = false;
+
+    std::lock_guard<std::mutex> lock(modules_mutex_);
+    default_module_.level_.store(LogLevel::Trace, std::memory_order_relaxed);
+    ApplyLevels();
+}
 
 void Logger::FlushOn(LogLevel lvl) { impl_->FlushOn(lvl); }
 
-void Logger::SetLevel(LogLevel level) { impl_->SetLevel(level); }
+void Logger::SetLevel(LogLevel level) {
+    std::lock_guard<std::mutex> lock(modules_mutex_);
+    default_module_.level_.store(level, std::memory_order_relaxed);
+    ApplyLevels();
+}
+
+LogLevel Logger::GetLevel() const { return default_module_.level(); }
+
+const LogModule& Logger::Module(std::string_view name) {
+    std::lock_guard<std::mutex> lock(modules_mutex_);
+    return FindOrAddModule(name);
+}
+
+void Logger::SetModuleLevel(std::string_view name, LogLevel level) {
+    std::lock_guard<std::mutex> lock(modules_mutex_);
+    auto& module       = FindOrAddModule(name);
+    module.overridden_ = true;
+    module.level_.store(level, std::memory_order_relaxed);
+    ApplyLevels();
+}
+
+void Logger::ResetModuleLevel(std::string_view name) {
+    std::lock_guard<std::mutex> lock(modules_mutex_);
+    FindOrAddModule(name).overridden_ = false;
+    ApplyLevels();
+}
+
+LogModule& Logger::FindOrAddModule(std::string_view name) {
+    auto it = modules_.find(name);
+    if (it == modules_.end()) {
+        it = modules_.emplace(std::string(name), std::make_unique<LogModule>(std::string(name), default_module_.level())).first;
+    }
+    return *it->second;
+}
+
+void Logger::ApplyLevels() {
+    const LogLevel global = default_module_.level();
+    LogLevel floor        = global;
+    for (auto& [name, module] : modules_) {
+        if (!module->overridden_) {
+            module->level_.store(global, std::memory_order_relaxed);
+        }
+        floor = std::min(floor, module->level());
+    }
+    floor_.store(floor, std::memory_order_relaxed);
+
+    // The backend filters too, so it has to let through whatever the most verbose module wants.
+    if (initialized_) {
+        impl_->SetLevel(floor);
+    }
+}
+
+void Logger::EnableAsync(std::size_t ring_bytes_per_thread) {
+    if (frontend_) {
+        return;
+    }
+    frontend_ = std::make_unique<AsyncLogFrontend>(*impl_, ring_bytes_per_thread);
+    async_.store(true, std::memory_order_release);
+}
+
+void Logger::DisableAsync() {
+    async_.store(false, std::memory_order_release);
+    frontend_.reset();
+}
+
+void Logger::Flush() {
+    if (frontend_) {
+        frontend_->Flush();
+    }
+}
+
+std::uint64_t Logger::DroppedRecords() const { return frontend_ ? frontend_->Dropped() : 0; }
+
+LogRing* Logger::ThreadRing() { return frontend_->ThreadRing(); }
 
-LogLevel Logger::GetLevel() const { return impl_->GetLevel(); }
+void Logger::CountDropped() { frontend_->CountDropped(); }
 
 }  // namespace eurora::utils
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <string>
 
 #include "eurora/utils/logger_level.h"
@@ -14,6 +15,10 @@ public:
 
     virtual void Log(const char* file, int line, const char* function, LogLevel level, const std::string& message) = 0;
 
+    /// Like Log, for records written after the fact: `time` is when the statement ran.
+    virtual void LogAt(std::chrono::system_clock::time_point time, const char* file, int line, const char* function, LogLevel level,
+                       const std::string& message) = 0;
+
     virtual void Shutdown() = 0;
 
     virtual void SetLevel(LogLevel level) = 0;
@@ -116,6 +116,15 @@ void LoggerImplSpdlog::Log(const char* file, int line, const char* function, Log
     logger_->log(loc, ToSpdlogLevel(level), message);
 }
 
+void LoggerImplSpdlog::LogAt(std::chrono::system_clock::time_point time, const char* file, int line, const char* function, LogLevel level,
+                             const std::string& message) {
+    if (!initialized_) {
+        throw std::runtime_error("SpdLogger is not initialized.");
+    }
+    spdlog::source_loc loc{file, line, function};
+    logger_->log(time, loc, ToSpdlogLevel(level), message);
+}
+
 void LoggerImplSpdlog::Shutdown() {
     initialized_ = false;
     spdlog::shutdown();
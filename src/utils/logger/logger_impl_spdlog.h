@@ -16,6 +16,9 @@ public:
 
     virtual void Log(const char* file, int line, const char* function, LogLevel level, const std::string& message) override;
 
+    virtual void LogAt(std::chrono::system_clock::time_point time, const char* file, int line, const char* function, LogLevel level,
+                       const std::string& message) override;
+
     virtual void Shutdown() override;
 
     virtual void SetLevel(LogLevel level) override;
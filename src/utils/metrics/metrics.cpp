@@ -0,0 +1,335 @@
+#include "eurora/utils/metrics.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <sstream>
+
+#include "eurora/utils/exception.hpp"
+
+namespace eurora::utils {
+
+namespace {
+
+constexpr double kQuantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+bool IsValidName(std::string_view name) {
+    if (name.empty()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < name.size(); ++i) {
+        const char c = name[i];
+        const bool valid =
+            (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':' || (i > 0 && c >= '0' && c <= '9');
+        if (!valid) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Renders labels as `a="x",b="y"`, escaped as the exposition format requires; the result also keys the series.
+std::string RenderLabels(const MetricLabels& labels) {
+    std::string text;
+    for (const auto& [key, value] : labels) {
+        if (!IsValidName(key) || key.find(':') != std::string::npos) {
+            EURORA_THROW_ERROR(ErrorCode::kAlgo_InvalidParameter, "Invalid metric label name: " + key);
+        }
+        if (!text.empty()) {
+            text += ',';
+        }
+        text += key;
+        text += "=\"";
+        for (char c : value) {
+            if (c == '\\' || c == '"') {
+                text += '\\';
+                text += c;
+            } else if (c == '\n') {
+                text += "\\n";
+            } else {
+                text += c;
+            }
+        }
+        text += '"';
+    }
+    return text;
+}
+
+void WriteSeries(std::ostream& os, std::string_view name, std::string_view suffix, const std::string& labels, std::string_view extra = {}) {
+    os << name << suffix;
+    if (!labels.empty() || !extra.empty()) {
+        os << '{' << labels;
+        if (!labels.empty() && !extra.empty()) {
+            os << ',';
+        }
+        os << extra << '}';
+    }
+    os << ' ';
+}
+
+void WriteValue(std::ostream& os, double value) {
+    if (std::isnan(value)) {
+        os << "NaN";
+    } else if (std::isinf(value)) {
+        os << (value > 0 ? "+Inf" : "-Inf");
+    } else {
+        char buffer[32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        os.write(buffer, result.ptr - buffer);
+    }
+    os << '\n';
+}
+
+}  // namespace
+
+/** Histogram **/
+
+Histogram::~Histogram() {
+    for (auto& shard : shards_) {
+        delete shard.load(std::memory_order_relaxed);
+    }
+}
+
+Histogram::Shard& Histogram::ThisThreadShard() {
+    auto& slot   = shards_[detail::ThisThreadMetricShard()];
+    Shard* shard = slot.load(std::memory_order_acquire);
+    if (shard == nullptr) {
+        auto* created = new Shard;
+        if (slot.compare_exchange_strong(shard, created, std::memory_order_acq_rel)) {
+            shard = created;
+        } else {
+            delete created;  // Another thread sharing the slot got there first.
+        }
+    }
+    return *shard;
+}
+
+void Histogram::Record(std::uint64_t value) {
+    Shard& shard = ThisThreadShard();
+    shard.buckets[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+
+    std::uint64_t max = max_.load(std::memory_order_relaxed);
+    while (value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+Histogram::Snapshot Histogram::TakeSnapshot() const {
+    Snapshot snapshot;
+    snapshot.buckets.assign(kBuckets, 0);
+    for (const auto& slot : shards_) {
+        const Shard* shard = slot.load(std::memory_order_acquire);
+        if (shard == nullptr) {
+            continue;
+        }
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            const std::uint64_t count = shard->buckets[i].load(std::memory_order_relaxed);
+            snapshot.buckets[i] += count;
+            snapshot.count += count;
+        }
+        snapshot.sum += shard->sum.load(std::memory_order_relaxed);
+    }
+    snapshot.max = max_.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+std::uint64_t Histogram::Snapshot::ValueAtQuantile(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    const auto rank    = std::max<std::uint64_t>(static_cast<std::uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(count))), 1);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(BucketUpperBound(i), max);
+        }
+    }
+    return max;
+}
+
+/** GaugeCallback **/
+
+GaugeCallback::~GaugeCallback() {
+    if (id_ != 0) {
+        MetricsRegistry::Instance().RemoveGaugeCallback(id_);
+    }
+}
+
+GaugeCallback& GaugeCallback::operator=(GaugeCallback&& other) noexcept {
+    if (this != &other) {
+        if (id_ != 0) {
+            MetricsRegistry::Instance().RemoveGaugeCallback(id_);
+        }
+        id_ = std::exchange(other.id_, 0);
+    }
+    return *this;
+}
+
+/** MetricsRegistry **/
+
+enum class MetricsRegistry::Type { kCounter, kGauge, kHistogram };
+
+struct MetricsRegistry::Family {
+    struct Series {
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+        double scale = 1.0;
+    };
+
+    struct Callback {
+        std::string labels;
+        std::function<double()> function;
+    };
+
+    std::string name;
+    std::string help;
+    Type type;
+    std::map<std::string, Series> series;  // By rendered labels.
+    std::map<std::uint64_t, Callback> callbacks;
+};
+
+MetricsRegistry::MetricsRegistry(Token) {}
+
+MetricsRegistry::~MetricsRegistry() = default;
+
+MetricsRegistry::Family& MetricsRegistry::GetFamily(std::string_view name, std::string_view help, Type type) {
+    if (!IsValidName(name)) {
+        EURORA_THROW_ERROR(ErrorCode::kAlgo_InvalidParameter, "Invalid metric name: " + std::string(name));
+    }
+
+    auto it = families_.find(name);
+    if (it == families_.end()) {
+        auto family  = std::make_unique<Family>();
+        family->name = std::string(name);
+        family->help = std::string(help);
+        family->type = type;
+        it           = families_.emplace(family->name, std::move(family)).first;
+    } else if (it->second->type != type) {
+        EURORA_THROW_ERROR(ErrorCode::kAlgo_InvalidParameter, "Metric " + std::string(name) + " is already registered with another type");
+    }
+    return *it->second;
+}
+
+Counter& MetricsRegistry::GetCounter(std::string_view name, std::string_view help, const MetricLabels& labels) {
+    auto key = RenderLabels(labels);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& series = GetFamily(name, help, Type::kCounter).series[key];
+    if (!series.counter) {
+        series.counter = std::make_unique<Counter>();
+    }
+    return *series.counter;
+}
+
+Gauge& MetricsRegistry::GetGauge(std::string_view name, std::string_view help, const MetricLabels& labels) {
+    auto key = RenderLabels(labels);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& series = GetFamily(name, help, Type::kGauge).series[key];
+    if (!series.gauge) {
+        series.gauge = std::make_unique<Gauge>();
+    }
+    return *series.gauge;
+}
+
+Histogram& MetricsRegistry::GetHistogram(std::string_view name, std::string_view help, const MetricLabels& labels, double scale) {
+    auto key = RenderLabels(labels);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& series = GetFamily(name, help, Type::kHistogram).series[key];
+    if (!series.histogram) {
+        series.histogram = std::make_unique<Histogram>();
+        series.scale     = scale;
+    }
+    return *series.histogram;
+}
+
+GaugeCallback MetricsRegistry::AddGaugeCallback(std::string_view name, std::string_view help, const MetricLabels& labels,
+                                                std::function<double()> callback) {
+    auto key = RenderLabels(labels);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& family  = GetFamily(name, help, Type::kGauge);
+    const auto id = next_callback_id_++;
+    family.callbacks.emplace(id, Family::Callback{std::move(key), std::move(callback)});
+    callbacks_.emplace(id, &family);
+    return GaugeCallback(id);
+}
+
+void MetricsRegistry::RemoveGaugeCallback(std::uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = callbacks_.find(id);
+    if (it != callbacks_.end()) {
+        it->second->callbacks.erase(id);
+        callbacks_.erase(it);
+    }
+}
+
+void MetricsRegistry::WritePrometheus(std::ostream& os) const {
+    // The lock only keeps the set of metrics stable; values are read with relaxed loads, as they are written. Callbacks
+    // run under it, so they must not register metrics themselves.
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (const auto& [name, family] : families_) {
+        os << "# HELP " << name << ' ';
+        for (char c : family->help) {
+            if (c == '\\') {
+                os << "\\\\";
+            } else if (c == '\n') {
+                os << "\\n";
+            } else {
+                os << c;
+            }
+        }
+        os << "\n# TYPE " << name << ' ';
+
+        switch (family->type) {
+            case Type::kCounter:
+                os << "counter\n";
+                for (const auto& [labels, series] : family->series) {
+                    WriteSeries(os, name, "", labels);
+                    os << series.counter->Value() << '\n';
+                }
+                break;
+
+            case Type::kGauge: {
+                os << "gauge\n";
+                std::map<std::string, double> values;
+                for (const auto& [labels, series] : family->series) {
+                    values[labels] += series.gauge->Value();
+                }
+                for (const auto& [id, callback] : family->callbacks) {
+                    values[callback.labels] += callback.function();
+                }
+                for (const auto& [labels, value] : values) {
+                    WriteSeries(os, name, "", labels);
+                    WriteValue(os, value);
+                }
+                break;
+            }
+
+            case Type::kHistogram:
+                os << "summary\n";
+                for (const auto& [labels, series] : family->series) {
+                    const auto snapshot = series.histogram->TakeSnapshot();
+                    for (double quantile : kQuantiles) {
+                        std::ostringstream extra;
+                        extra << "quantile=\"" << quantile << '"';
+                        WriteSeries(os, name, "", labels, extra.str());
+                        WriteValue(os, static_cast<double>(snapshot.ValueAtQuantile(quantile)) * series.scale);
+                    }
+                    WriteSeries(os, name, "_sum", labels);
+                    WriteValue(os, static_cast<double>(snapshot.sum) * series.scale);
+                    WriteSeries(os, name, "_count", labels);
+                    os << snapshot.count << '\n';
+                }
+                break;
+        }
+    }
+}
+
+std::string MetricsRegistry::ExportPrometheus() const {
+    std::ostringstream os;
+    WritePrometheus(os);
+    return os.str();
+}
+
+}  // namespace eurora::utils
@@ -0,0 +1,76 @@
+#include "eurora/utils/resource_usage.h"
+
+#include <ctime>
+
+namespace eurora::utils {
+
+namespace {
+
+std::int64_t ThreadCpuNanos() {
+    timespec now{};
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return (std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec)).count();
+}
+
+// Moves the thread's pending charges into its account and restarts the accumulators.
+void FlushThreadState(detail::ResourceThreadState& state) {
+    if (state.account == nullptr) {
+        return;
+    }
+    const auto cpu_now = ThreadCpuNanos();
+    state.account->AddCpu(std::chrono::nanoseconds(cpu_now - state.cpu_start_ns));
+    state.account->AddBytes(state.bytes_read, state.bytes_written);
+    state.bytes_read    = 0;
+    state.bytes_written = 0;
+    state.cpu_start_ns  = cpu_now;
+}
+
+}  // namespace
+
+void ResourceAccount::AddStage(std::string_view stage, std::chrono::nanoseconds wall_time) {
+    std::lock_guard<std::mutex> lock(stages_mutex_);
+    auto it = stages_.find(stage);
+    if (it == stages_.end()) {
+        it = stages_.emplace(std::string(stage), std::chrono::nanoseconds{0}).first;
+    }
+    it->second += wall_time;
+}
+
+void ResourceAccount::UpdatePeakMemory(std::uint64_t bytes) {
+    std::uint64_t peak = peak_memory_.load(std::memory_order_relaxed);
+    while (bytes > peak && !peak_memory_.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {
+    }
+}
+
+ResourceUsage ResourceAccount::Usage() const {
+    ResourceUsage usage;
+    {
+        std::lock_guard<std::mutex> lock(stages_mutex_);
+        for (const auto& [stage, wall_time] : stages_) {
+            usage.stage_seconds.emplace(stage, std::chrono::duration<double>(wall_time).count());
+        }
+    }
+    usage.cpu_seconds       = std::chrono::duration<double>(std::chrono::nanoseconds(cpu_ns_.load(std::memory_order_relaxed))).count();
+    usage.peak_memory_bytes = peak_memory_.load(std::memory_order_relaxed);
+    usage.bytes_read        = bytes_read_.load(std::memory_order_relaxed);
+    usage.bytes_written     = bytes_written_.load(std::memory_order_relaxed);
+    return usage;
+}
+
+ResourceScope::ResourceScope(ResourceAccount* account) : previous_(detail::resource_thread_state.account) {
+    auto& state = detail::resource_thread_state;
+    FlushThreadState(state);
+    state.account      = account;
+    state.cpu_start_ns = ThreadCpuNanos();
+}
+
+ResourceScope::~ResourceScope() {
+    auto& state = detail::resource_thread_state;
+    FlushThreadState(state);
+    state.account      = previous_;
+    state.cpu_start_ns = ThreadCpuNanos();
+}
+
+void ResourceScope::Flush() { FlushThreadState(detail::resource_thread_state); }
+
+}  // namespace eurora::utils
@@ -0,0 +1,286 @@
+#include "eurora/utils/trace.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace eurora::utils {
+
+namespace {
+
+constexpr std::size_t kChunkEvents = 4096;
+
+struct Chunk {
+    TraceEvent events[kChunkEvents];
+    std::atomic<std::size_t> count{0};  // Published with release after the event is written.
+    std::atomic<Chunk*> next{nullptr};
+};
+
+/// One thread's events for one session. Only the owning thread appends; exports read the published prefix.
+struct EventLog {
+    explicit EventLog(std::size_t max_events) : limit(max_events), tail(&head) {}
+
+    ~EventLog() {
+        for (Chunk* chunk = head.next.load(); chunk != nullptr;) {
+            Chunk* next = chunk->next.load();
+            delete chunk;
+            chunk = next;
+        }
+    }
+
+    const std::size_t limit;
+    std::size_t recorded = 0;  // Owner only.
+    std::atomic<std::uint64_t> dropped{0};
+    Chunk head;
+    Chunk* tail;  // Owner only.
+};
+
+struct ThreadBuffer {
+    explicit ThreadBuffer(int id) : tid(id) {}
+
+    const int tid;
+    std::atomic<bool> exited{false};
+
+    std::mutex mutex;  // Guards the two fields below; the owner takes it only when a session starts.
+    std::shared_ptr<EventLog> log;
+    std::string name;
+};
+
+void WriteJsonString(std::ostream& os, std::string_view text) {
+    os << '"';
+    for (char c : text) {
+        switch (c) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            case '\n':
+                os << "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    os << ' ';
+                } else {
+                    os << c;
+                }
+        }
+    }
+    os << '"';
+}
+
+}  // namespace
+
+struct Tracer::Impl {
+    std::shared_ptr<ThreadBuffer> Register() {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto buffer = std::make_shared<ThreadBuffer>(next_tid++);
+        threads.push_back(buffer);
+        return buffer;
+    }
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> threads;
+    int next_tid = 1;
+
+    std::atomic<std::uint64_t> session{0};
+    std::atomic<std::size_t> max_events{kDefaultEventsPerThread};
+    std::atomic<std::int64_t> session_start_ns{0};
+};
+
+namespace {
+
+/// The calling thread's view: its buffer and the log it appends to, which it keeps alive even after a new session.
+struct ThreadHandle {
+    ~ThreadHandle() {
+        if (buffer) {
+            buffer->exited.store(true, std::memory_order_release);
+        }
+    }
+
+    std::shared_ptr<ThreadBuffer> buffer;
+    std::shared_ptr<EventLog> log;
+    std::uint64_t session = 0;
+};
+
+thread_local ThreadHandle this_thread;
+
+}  // namespace
+
+Tracer::Tracer(Token) : impl_(std::make_unique<Impl>()) {}
+
+Tracer::~Tracer() = default;
+
+void Tracer::Start(std::size_t max_events_per_thread) {
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        std::erase_if(impl_->threads, [](const auto& buffer) { return buffer->exited.load(std::memory_order_acquire); });
+        for (const auto& buffer : impl_->threads) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            buffer->log.reset();
+        }
+    }
+    impl_->max_events.store(max_events_per_thread, std::memory_order_relaxed);
+    impl_->session_start_ns.store(Now(), std::memory_order_relaxed);
+    impl_->session.fetch_add(1, std::memory_order_release);
+    enabled_.store(true, std::memory_order_release);
+}
+
+void Tracer::Stop() { enabled_.store(false, std::memory_order_release); }
+
+void Tracer::Record(const TraceEvent& event) {
+    auto& handle = this_thread;
+    if (!handle.buffer) {
+        handle.buffer = impl_->Register();
+    }
+
+    const std::uint64_t session = impl_->session.load(std::memory_order_acquire);
+    if (handle.session != session) {
+        handle.log     = std::make_shared<EventLog>(impl_->max_events.load(std::memory_order_relaxed));
+        handle.session = session;
+        std::lock_guard<std::mutex> lock(handle.buffer->mutex);
+        handle.buffer->log = handle.log;
+    }
+
+    EventLog& log = *handle.log;
+    if (log.recorded >= log.limit) {
+        log.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Chunk* chunk      = log.tail;
+    std::size_t count = chunk->count.load(std::memory_order_relaxed);
+    if (count == kChunkEvents) {
+        auto* next = new Chunk;
+        chunk->next.store(next, std::memory_order_release);
+        log.tail = next;
+        chunk    = next;
+        count    = 0;
+    }
+    chunk->events[count] = event;
+    chunk->count.store(count + 1, std::memory_order_release);
+    ++log.recorded;
+}
+
+void Tracer::SetThreadName(const std::string& name) {
+    auto& handle = this_thread;
+    if (!handle.buffer) {
+        handle.buffer = impl_->Register();
+    }
+    std::lock_guard<std::mutex> lock(handle.buffer->mutex);
+    handle.buffer->name = name;
+}
+
+namespace {
+
+struct Snapshot {
+    int tid;
+    std::string name;
+    std::shared_ptr<EventLog> log;
+};
+
+std::vector<Snapshot> TakeSnapshot(std::mutex& mutex, const std::vector<std::shared_ptr<ThreadBuffer>>& threads) {
+    std::vector<Snapshot> snapshot;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& buffer : threads) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        snapshot.push_back({buffer->tid, buffer->name, buffer->log});
+    }
+    return snapshot;
+}
+
+template <typename Visit>
+void ForEachEvent(const EventLog& log, Visit&& visit) {
+    for (const Chunk* chunk = &log.head; chunk != nullptr; chunk = chunk->next.load(std::memory_order_acquire)) {
+        const std::size_t count = chunk->count.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; ++i) {
+            visit(chunk->events[i]);
+        }
+    }
+}
+
+}  // namespace
+
+void Tracer::WriteChromeTrace(std::ostream& os) const {
+    const auto snapshot      = TakeSnapshot(impl_->mutex, impl_->threads);
+    const std::int64_t start = impl_->session_start_ns.load(std::memory_order_relaxed);
+
+    const auto flags     = os.flags();
+    const auto precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first    = true;
+    auto separate = [&os, &first]() {
+        os << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    for (const auto& thread : snapshot) {
+        if (!thread.name.empty()) {
+            separate();
+            os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.tid << ",\"args\":{\"name\":";
+            WriteJsonString(os, thread.name);
+            os << "}}";
+        }
+        if (!thread.log) {
+            continue;
+        }
+        ForEachEvent(*thread.log, [&](const TraceEvent& event) {
+            separate();
+            os << "{\"name\":";
+            WriteJsonString(os, event.name);
+            os << ",\"cat\":";
+            WriteJsonString(os, event.category);
+            os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread.tid << ",\"ts\":" << static_cast<double>(event.start_ns - start) / 1000.0
+               << ",\"dur\":" << static_cast<double>(event.duration_ns) / 1000.0;
+            if (event.arg_name != nullptr) {
+                os << ",\"args\":{";
+                WriteJsonString(os, event.arg_name);
+                os << ':' << event.arg_value << '}';
+            }
+            os << '}';
+        });
+    }
+    os << "\n]}\n";
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+bool Tracer::ExportChromeTrace(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    WriteChromeTrace(file);
+    return static_cast<bool>(file.flush());
+}
+
+std::size_t Tracer::EventCount() const {
+    std::size_t count = 0;
+    for (const auto& thread : TakeSnapshot(impl_->mutex, impl_->threads)) {
+        if (thread.log) {
+            for (const Chunk* chunk = &thread.log->head; chunk != nullptr; chunk = chunk->next.load(std::memory_order_acquire)) {
+                count += chunk->count.load(std::memory_order_acquire);
+            }
+        }
+    }
+    return count;
+}
+
+std::uint64_t Tracer::DroppedEvents() const {
+    std::uint64_t dropped = 0;
+    for (const auto& thread : TakeSnapshot(impl_->mutex, impl_->threads)) {
+        if (thread.log) {
+            dropped += thread.log->dropped.load(std::memory_order_relaxed);
+        }
+    }
+    return dropped;
+}
+
+}  // namespace eurora::utils
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "apps/frontend/task_manager.h"
+
+using namespace eurora::fe;
+
+namespace {
+
+TaskManager::ListQuery Query(std::size_t limit, std::optional<std::string> status = std::nullopt) {
+    TaskManager::ListQuery query;
+    query.status = std::move(status);
+    query.limit  = limit;
+    return query;
+}
+
+// Follows next_cursor until the last page and returns the ids in the order they were listed.
+std::vector<std::string> ListAll(const TaskManager& manager, TaskManager::ListQuery query, std::size_t& pages) {
+    std::vector<std::string> ids;
+    pages = 0;
+    do {
+        auto page = manager.listTasks(query);
+        ++pages;
+        for (const auto& task : page.tasks) {
+            ids.push_back(task->id);
+        }
+        query.after = page.next_cursor;
+    } while (query.after != 0 && pages < 100);
+    return ids;
+}
+
+}  // namespace
+
+TEST(TaskManagerTest, PagesThroughASingleShard) {
+    TaskManager manager(1);
+    std::vector<std::string> created;
+    for (int i = 0; i < 5; ++i) {
+        created.push_back(manager.createTask({"in.h5"}, "out.h5"));
+    }
+
+    auto first = manager.listTasks(Query(2));
+    ASSERT_EQ(first.tasks.size(), 2u);
+    EXPECT_EQ(first.next_cursor, 2u);
+
+    std::size_t pages = 0;
+    EXPECT_EQ(ListAll(manager, Query(2), pages), created);
+    EXPECT_EQ(pages, 3u);
+}
+
+TEST(TaskManagerTest, LastFullPageHasNoCursor) {
+    TaskManager manager(1);
+    for (int i = 0; i < 4; ++i) {
+        (void)manager.createTask({"in.h5"}, "out.h5");
+    }
+
+    std::size_t pages = 0;
+    EXPECT_EQ(ListAll(manager, Query(2), pages).size(), 4u);
+    EXPECT_EQ(pages, 2u);
+}
+
+TEST(TaskManagerTest, PagesThroughAStatusWhoseTasksShareAShard) {
+    TaskManager manager(16);
+    for (int i = 0; i < 40; ++i) {
+        (void)manager.createTask({"in.h5"}, "out.h5");
+    }
+    // Ids 1, 17 and 33 all live in shard 1.
+    for (const char* id : {"1", "17", "33"}) {
+        manager.updateTaskStatus(id, TaskManager::kCompleted);
+    }
+
+    auto first = manager.listTasks(Query(2, TaskManager::kCompleted));
+    ASSERT_EQ(first.tasks.size(), 2u);
+    EXPECT_EQ(first.next_cursor, 17u);
+
+    std::size_t pages = 0;
+    const auto ids = ListAll(manager, Query(2, TaskManager::kCompleted), pages);
+    EXPECT_EQ(ids, (std::vector<std::string>{"1", "17", "33"}));
+    EXPECT_EQ(pages, 2u);
+}
+
+TEST(TaskManagerTest, MergesShardsInIdOrder) {
+    TaskManager manager(4);
+    std::vector<std::string> created;
+    for (int i = 0; i < 11; ++i) {
+        created.push_back(manager.createTask({"in.h5"}, "out.h5"));
+    }
+
+    std::size_t pages = 0;
+    EXPECT_EQ(ListAll(manager, Query(3), pages), created);
+    EXPECT_EQ(pages, 4u);
+}
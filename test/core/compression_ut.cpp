@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/compressed_storage_client.h"
+
+using namespace eurora::core;
+
+namespace {
+
+std::vector<float> Signal(std::size_t size) {
+    std::vector<float> values(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        values[i] = static_cast<float>(std::sin(static_cast<double>(i) * 0.001));
+    }
+    return values;
+}
+
+std::string Compress(const std::string& raw, const io::CompressionOptions& options, ThreadPool* pool = nullptr) {
+    std::stringstream sink;
+    io::CompressingStreamBuf buffer(sink, options, pool, 4);
+    std::ostream stream(&buffer);
+    stream.write(raw.data(), static_cast<std::streamsize>(raw.size()));
+    buffer.finish();
+    return sink.str();
+}
+
+std::string Decompress(const std::string& stored) {
+    io::DecompressingStream stream(std::make_shared<std::istringstream>(stored));
+    return {std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+}
+
+class MemoryClient : public StorageClient {
+public:
+    MemoryClient() : StorageClient("memory://") {}
+
+    StorageItemList list_items(const StorageItemTags& tags, size_t) override {
+        StorageItemList list;
+        list.complete = true;
+        for (const auto& [key, item] : items) {
+            if (tags.matches(item.tags)) {
+                list.items.push_back(item);
+            }
+        }
+        return list;
+    }
+    StorageItemList get_next_page_of_items(const StorageItemList& page) override { return page; }
+    std::shared_ptr<std::istream> get_latest_item(const StorageItemTags& tags) override {
+        auto list = list_items(tags, 1);
+        return list.items.empty() ? nullptr : std::make_shared<std::istringstream>(list.items.back().data);
+    }
+    std::shared_ptr<std::istream> get_item_by_url(std::string_view) override { return nullptr; }
+    std::optional<std::string> health_check() override { return std::nullopt; }
+
+    StorageItem store_item(const StorageItemTags& tags, std::istream& data, std::optional<std::chrono::seconds>) override {
+        StorageItem item;
+        item.tags = tags;
+        item.data = std::string(std::istreambuf_iterator<char>(data), std::istreambuf_iterator<char>());
+        items[tags.key()] = item;
+        return item;
+    }
+
+    std::map<std::string, StorageItem> items;
+};
+
+}  // namespace
+
+TEST(CompressionTest, RoundTripsWithEachCodec) {
+    auto signal = Signal(600'000);
+    std::string raw(reinterpret_cast<const char*>(signal.data()), signal.size() * sizeof(float));
+
+    for (auto options : {io::CompressionOptions::Fast(), io::CompressionOptions::Archive(), io::CompressionOptions{.codec = io::Codec::kNone}}) {
+        auto stored = Compress(raw, options);
+        EXPECT_EQ(Decompress(stored), raw) << io::CodecName(options.codec);
+        if (options.codec != io::Codec::kNone) {
+            EXPECT_LT(stored.size(), raw.size()) << io::CodecName(options.codec);
+        }
+    }
+}
+
+TEST(CompressionTest, ShuffleImprovesFloatCompression) {
+    auto signal = Signal(300'000);
+    std::string raw(reinterpret_cast<const char*>(signal.data()), signal.size() * sizeof(float));
+
+    auto shuffled = Compress(raw, {.codec = io::Codec::kLz4, .type_size = 4});
+    auto plain    = Compress(raw, {.codec = io::Codec::kLz4, .type_size = 1});
+    EXPECT_LT(shuffled.size(), plain.size());
+}
+
+TEST(CompressionTest, ParallelOutputMatchesSerial) {
+    ThreadPool pool(4);
+    auto signal = Signal(1'000'000);
+    std::string raw(reinterpret_cast<const char*>(signal.data()), signal.size() * sizeof(float));
+    io::CompressionOptions options{.codec = io::Codec::kLz4, .block_size = 64 * 1024};
+
+    EXPECT_EQ(Compress(raw, options, &pool), Compress(raw, options));
+}
+
+TEST(CompressionTest, PassesUncompressedDataThrough) {
+    EXPECT_EQ(Decompress("plain text payload"), "plain text payload");
+    EXPECT_EQ(Decompress("abc"), "abc");
+    EXPECT_EQ(Decompress(""), "");
+}
+
+TEST(CompressionTest, RejectsCorruptBlocks) {
+    std::string raw(200'000, 'x');
+    auto stored = Compress(raw, io::CompressionOptions::Fast());
+    stored[stored.size() / 2] ^= 0x5a;
+    stored.resize(stored.size() - 10);
+
+    EXPECT_THROW(Decompress(stored), eurora::utils::Exception);
+
+    // Zero type or block sizes in the header would otherwise divide by zero while unshuffling.
+    auto zero_type_size = Compress(raw, io::CompressionOptions::Fast());
+    zero_type_size[6]   = 0;
+    EXPECT_THROW(Decompress(zero_type_size), eurora::utils::Exception);
+
+    auto zero_block_size = Compress(raw, io::CompressionOptions::Fast());
+    std::fill(zero_block_size.begin() + 8, zero_block_size.begin() + 12, '\0');
+    EXPECT_THROW(Decompress(zero_block_size), eurora::utils::Exception);
+}
+
+TEST(CompressionTest, ClientRecordsCodecAndDecompressesReads) {
+    auto memory = std::make_shared<MemoryClient>();
+    CompressedStorageClient client(memory, io::CompressionOptions::Archive(), 2);
+    auto tags = StorageItemTags::Builder("subject").with_name("kspace").build();
+
+    auto signal = Signal(100'000);
+    client.store_item_streamed(tags, [&signal](std::ostream& stream) { io::write(stream, signal); });
+
+    auto listed = client.list_items(tags);
+    ASSERT_EQ(listed.items.size(), 1u);
+    auto codec = listed.items[0].tags.custom_tags.find(CompressedStorageClient::kCodecTag);
+    ASSERT_NE(codec, listed.items[0].tags.custom_tags.end());
+    EXPECT_EQ(codec->second, "zstd");
+    EXPECT_LT(listed.items[0].data.size(), signal.size() * sizeof(float));
+
+    auto stream = client.get_latest_item(tags);
+    ASSERT_NE(stream, nullptr);
+    EXPECT_EQ(io::read<std::vector<float>>(*stream), signal);
+}
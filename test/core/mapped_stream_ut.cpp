@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <unistd.h>
+
+#include "core/io/mapped_stream.hpp"
+
+using namespace eurora::utils;
+using namespace eurora::core::io;
+
+class MappedStreamTest : public ::testing::Test {
+protected:
+    void SetUp() override { path_ = std::filesystem::temp_directory_path() / ("mapped_stream_ut_" + std::to_string(::getpid())); }
+
+    void TearDown() override { std::filesystem::remove(path_); }
+
+    void WriteFile(const std::string& content) { std::ofstream(path_, std::ios::binary) << content; }
+
+    std::filesystem::path path_;
+};
+
+TEST_F(MappedStreamTest, ReadsWholeFile) {
+    WriteFile("line one\nline two\n");
+    MappedFileStream stream(path_);
+
+    std::string first, second;
+    std::getline(stream, first);
+    std::getline(stream, second);
+
+    EXPECT_EQ(first, "line one");
+    EXPECT_EQ(second, "line two");
+    EXPECT_EQ(stream.size(), 18u);
+}
+
+TEST_F(MappedStreamTest, SeeksFromAllOrigins) {
+    WriteFile("0123456789");
+    MappedFileStream stream(path_);
+
+    stream.seekg(4);
+    EXPECT_EQ(stream.get(), '4');
+    stream.seekg(2, std::ios::cur);
+    EXPECT_EQ(stream.get(), '7');
+    stream.seekg(-1, std::ios::end);
+    EXPECT_EQ(stream.get(), '9');
+    EXPECT_EQ(stream.get(), std::char_traits<char>::eof());
+}
+
+TEST_F(MappedStreamTest, EmptyFileIsEmptyStream) {
+    WriteFile("");
+    MappedFileStream stream(path_);
+
+    EXPECT_EQ(stream.get(), std::char_traits<char>::eof());
+    EXPECT_TRUE(stream.eof());
+}
+
+TEST_F(MappedStreamTest, SurvivesUnlink) {
+    WriteFile("still here");
+    MappedFileStream stream(path_);
+    std::filesystem::remove(path_);
+
+    std::string content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(content, "still here");
+}
+
+TEST_F(MappedStreamTest, MissingFileThrows) { EXPECT_THROW(MappedFileStream stream(path_), Exception); }
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iterator>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/messaging/mpmc_channel.h"
+#include "core/task.hpp"
+
+using namespace eurora::core;
+using namespace std::chrono_literals;
+
+class MPMCChannelTest : public ::testing::Test {};
+
+namespace {
+
+Task<int> SumUntilClosed(MPMCChannel<int>& channel) {
+    int total = 0;
+    try {
+        while (true) {
+            total += co_await channel.async_pop();
+        }
+    } catch (const ChannelClosed&) {
+    }
+    co_return total;
+}
+
+}  // namespace
+
+TEST_F(MPMCChannelTest, PushAndPop) {
+    MPMCChannel<std::string> channel;
+    channel.push("a");
+    channel.emplace(2, 'b');
+
+    EXPECT_EQ(channel.size(), 2u);
+    EXPECT_EQ(channel.pop(), "a");
+    EXPECT_EQ(channel.try_pop(), "bb");
+    EXPECT_FALSE(channel.try_pop().has_value());
+    EXPECT_TRUE(channel.empty());
+}
+
+TEST_F(MPMCChannelTest, BulkTransfersKeepOrderAcrossThreads) {
+    MPMCChannel<int> channel;
+    constexpr int kBatches   = 200;
+    constexpr int kBatchSize = 256;
+
+    std::thread producer([&channel]() {
+        std::vector<int> batch(kBatchSize);
+        for (int b = 0; b < kBatches; ++b) {
+            for (int i = 0; i < kBatchSize; ++i) {
+                batch[static_cast<size_t>(i)] = b * kBatchSize + i;
+            }
+            channel.push_bulk(batch);
+        }
+        channel.close();
+    });
+
+    std::vector<int> received;
+    try {
+        while (true) {
+            channel.pop_bulk(std::back_inserter(received), 100);
+        }
+    } catch (const ChannelClosed&) {}
+    producer.join();
+
+    ASSERT_EQ(received.size(), static_cast<size_t>(kBatches * kBatchSize));
+    for (size_t i = 0; i < received.size(); ++i) {
+        ASSERT_EQ(received[i], static_cast<int>(i));
+    }
+    EXPECT_EQ(channel.size(), 0u);
+    EXPECT_THROW(channel.push_bulk(std::vector<int>{1}), ChannelClosed);
+}
+
+TEST_F(MPMCChannelTest, TimedAndCancellableWaits) {
+    MPMCChannel<int> channel;
+
+    EXPECT_FALSE(channel.pop_for(std::chrono::milliseconds(10)).has_value());
+    channel.push(1);
+    EXPECT_EQ(channel.pop_until(std::chrono::steady_clock::now() + std::chrono::seconds(10)), 1);
+
+    std::stop_source cancelled;
+    std::thread consumer([&channel, token = cancelled.get_token()]() {
+        std::vector<int> batch;
+        EXPECT_EQ(channel.pop_bulk_until(std::back_inserter(batch), 8, std::chrono::steady_clock::now() + std::chrono::hours(1), token), 0u);
+        EXPECT_FALSE(channel.pop(token).has_value());
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    cancelled.request_stop();
+    consumer.join();
+
+    channel.push(2);
+    channel.close();
+    EXPECT_EQ(channel.pop_for(std::chrono::seconds(10)), 2);
+    EXPECT_THROW(channel.pop_for(std::chrono::seconds(10)), ChannelClosed);
+}
+
+TEST_F(MPMCChannelTest, AsyncPopSuspendsUntilPushedOrClosed) {
+    MPMCChannel<int> channel;
+    channel.push(1);
+
+    // The first consumer takes the queued item without suspending; both then wait for pushes.
+    auto first  = Spawn(SumUntilClosed(channel));
+    auto second = Spawn(SumUntilClosed(channel));
+    EXPECT_EQ(first.wait_for(0s), std::future_status::timeout);
+
+    channel.push(10);
+    channel.push_bulk(std::vector<int>{100, 1000});
+    EXPECT_TRUE(channel.empty());
+
+    channel.close();
+    EXPECT_EQ(first.get() + second.get(), 1111);
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+#include "core/numa.hpp"
+
+using namespace eurora::core;
+
+TEST(NumaTest, ParsesKernelLists) {
+    EXPECT_EQ(numa::ParseList("0-3,8,10-11"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(numa::ParseList("5"), (std::vector<int>{5}));
+    EXPECT_TRUE(numa::ParseList("").empty());
+}
+
+TEST(NumaTest, EveryNodeHasCpus) {
+    auto nodes = numa::Nodes();
+    ASSERT_FALSE(nodes.empty());
+    for (const auto& node : nodes) {
+        EXPECT_GE(node.id, 0);
+        EXPECT_FALSE(node.cpus.empty());
+    }
+}
+
+TEST(NumaTest, NodeLocalBuffersLandOnTheirNode) {
+    const auto node = numa::Nodes().front().id;
+
+    std::vector<float, numa::NodeLocalAllocator<float>> buffer(1 << 20, 1.0f, numa::NodeLocalAllocator<float>(node));
+    EXPECT_EQ(buffer.get_allocator().node(), node);
+    if (auto placed = numa::NodeOfAddress(buffer.data() + buffer.size() / 2)) {
+        EXPECT_EQ(*placed, node);
+    }
+
+    // Small buffers come from the heap.
+    std::vector<int, numa::NodeLocalAllocator<int>> small(16, 7);
+    EXPECT_EQ(small[15], 7);
+
+    std::vector<double> filled(1 << 18, 2.0);
+    if (numa::NodeOfAddress(filled.data())) {
+        EXPECT_TRUE(numa::BindBuffer(filled, node));
+    }
+}
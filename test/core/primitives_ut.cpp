@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <optional>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "core/io/primitives.h"
+
+using namespace eurora::core;
+
+namespace {
+
+// Records the size of every write that reaches the sink.
+class ChunkRecorder : public std::streambuf {
+public:
+    std::vector<std::size_t> writes;
+
+protected:
+    std::streamsize xsputn(const char*, std::streamsize count) override {
+        writes.push_back(static_cast<std::size_t>(count));
+        return count;
+    }
+    int_type overflow(int_type ch) override {
+        writes.push_back(1);
+        return ch;
+    }
+};
+
+struct Point {
+    int x;
+    double y;
+};
+
+}  // namespace
+
+TEST(PrimitivesTest, RoundTripsValues) {
+    std::stringstream stream;
+    io::write(stream, 42);
+    io::write(stream, Point{1, 2.5});
+    io::write(stream, std::string("coil maps"));
+    io::write(stream, std::vector<float>{1.0f, 2.0f, 3.0f});
+    io::write(stream, std::vector<std::string>{"a", "bc"});
+    io::write(stream, std::optional<int>());
+    io::write(stream, std::optional<std::string>("set"));
+
+    EXPECT_EQ(io::read<int>(stream), 42);
+    auto point = io::read<Point>(stream);
+    EXPECT_EQ(point.x, 1);
+    EXPECT_EQ(point.y, 2.5);
+    EXPECT_EQ(io::read<std::string>(stream), "coil maps");
+    EXPECT_EQ(io::read<std::vector<float>>(stream), (std::vector<float>{1.0f, 2.0f, 3.0f}));
+    EXPECT_EQ(io::read<std::vector<std::string>>(stream), (std::vector<std::string>{"a", "bc"}));
+    EXPECT_EQ(io::read<std::optional<int>>(stream), std::nullopt);
+    EXPECT_EQ(io::read<std::optional<std::string>>(stream), "set");
+}
+
+TEST(PrimitivesTest, WritesLargeArraysInBoundedChunks) {
+    std::vector<double> values(io::kChunkSize / sizeof(double) * 3 + 7, 1.0);
+    ChunkRecorder sink;
+    std::ostream stream(&sink);
+
+    io::write(stream, values.data(), values.size());
+
+    ASSERT_EQ(sink.writes.size(), 4u);
+    std::size_t total = 0;
+    for (auto size : sink.writes) {
+        EXPECT_LE(size, io::kChunkSize);
+        total += size;
+    }
+    EXPECT_EQ(total, values.size() * sizeof(double));
+}
+
+TEST(PrimitivesTest, FillsPresizedBuffers) {
+    std::vector<int> source{1, 2, 3, 4};
+    std::stringstream stream;
+    io::write(stream, source.data(), source.size());
+
+    std::vector<int> target(4);
+    const int* buffer = target.data();
+    io::read(stream, target.data(), target.size());
+    EXPECT_EQ(target, source);
+    EXPECT_EQ(target.data(), buffer);
+}
+
+TEST(PrimitivesTest, ThrowsOnTruncatedInput) {
+    std::stringstream stream;
+    io::write(stream, std::vector<int>{1, 2, 3});
+    auto bytes = stream.str();
+    std::stringstream truncated(bytes.substr(0, bytes.size() - 2));
+
+    EXPECT_THROW(io::read<std::vector<int>>(truncated), eurora::utils::Exception);
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include "core/priority_task_queue.hpp"
+
+using namespace eurora::utils;
+using namespace eurora::core;
+
+class PriorityTaskQueueTest : public ::testing::Test {};
+
+TEST_F(PriorityTaskQueueTest, DefaultScheduleKeepsArrivalOrder) {
+    PriorityTaskQueue<int> queue;
+    for (int i = 0; i < 5; ++i) {
+        queue.Push(i);
+    }
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(queue.Pop(), i);
+    }
+    EXPECT_TRUE(queue.Empty());
+}
+
+TEST_F(PriorityTaskQueueTest, InteractiveOvertakesBatchAndDeadlinesComeFirst) {
+    PriorityTaskQueue<int> queue;
+    queue.Push(1, {TaskPriority::kBatch});
+    queue.Push(2, {TaskPriority::kNormal});
+    queue.Push(3, {TaskPriority::kInteractive});
+    queue.Push(4, {TaskPriority::kBatch, std::chrono::steady_clock::now() - std::chrono::seconds(1)});
+    EXPECT_EQ(queue.Size(), 4u);
+
+    EXPECT_EQ(queue.Pop(), 4);
+    EXPECT_EQ(queue.Pop(), 3);
+    EXPECT_EQ(queue.Pop(), 2);
+    EXPECT_EQ(queue.Pop(), 1);
+}
+
+TEST_F(PriorityTaskQueueTest, WaitingBatchWorkAgesPastNewInteractiveWork) {
+    PriorityTaskQueue<int> queue({std::chrono::milliseconds(0), std::chrono::milliseconds(0), std::chrono::milliseconds(20)});
+    queue.Push(1, {TaskPriority::kBatch});
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    queue.Push(2, {TaskPriority::kInteractive});
+
+    EXPECT_EQ(queue.Pop(), 1);
+    EXPECT_EQ(queue.Pop(), 2);
+}
+
+TEST_F(PriorityTaskQueueTest, CloseDrainsRemainingTasks) {
+    PriorityTaskQueue<int> queue;
+    queue.Push(1, {TaskPriority::kBatch});
+    queue.Close();
+
+    EXPECT_THROW(queue.Push(2), QueueClosed);
+    EXPECT_EQ(queue.Pop(), 1);
+    EXPECT_THROW(queue.Pop(), QueueClosed);
+    EXPECT_FALSE(queue.TryPop().has_value());
+}
+
+TEST_F(PriorityTaskQueueTest, ParsesPriorityNames) {
+    EXPECT_EQ(ParseTaskPriority("interactive"), TaskPriority::kInteractive);
+    EXPECT_EQ(ParseTaskPriority("batch"), TaskPriority::kBatch);
+    EXPECT_EQ(ToString(TaskPriority::kNormal), "normal");
+    EXPECT_FALSE(ParseTaskPriority("urgent").has_value());
+}
@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "core/sha256.hpp"
+
+using namespace eurora::core;
+
+class Sha256Test : public ::testing::Test {};
+
+TEST_F(Sha256Test, KnownVectors) {
+    EXPECT_EQ(Sha256::HexDigest(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(Sha256::HexDigest("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(Sha256::HexDigest("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+              "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
+
+TEST_F(Sha256Test, IncrementalMatchesOneShot) {
+    std::string data(1000003, '\0');
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<char>(i * 31 + 7);
+    }
+
+    Sha256 hash;
+    for (std::size_t offset = 0, step = 1; offset < data.size(); offset += step, step = step % 97 + 13) {
+        hash.Update(data.data() + offset, std::min(step, data.size() - offset));
+    }
+
+    EXPECT_EQ(Sha256::ToHex(hash.Final()), Sha256::HexDigest(data));
+}
+
+TEST_F(Sha256Test, MillionAs) {
+    Sha256 hash;
+    std::string chunk(1000, 'a');
+    for (int i = 0; i < 1000; ++i) {
+        hash.Update(chunk.data(), chunk.size());
+    }
+    EXPECT_EQ(Sha256::ToHex(hash.Final()), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
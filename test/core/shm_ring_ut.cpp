@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "core/messaging/shm_ring.hpp"
+
+using namespace eurora::utils;
+using namespace Core::Messaging;
+
+namespace {
+
+void Write(ShmRing& ring, uint32_t value, std::size_t size) {
+    auto span = ring.Reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        span[i] = static_cast<std::byte>(value + i);
+    }
+    ring.Commit();
+}
+
+bool Matches(std::span<const std::byte> record, uint32_t value, std::size_t size) {
+    if (record.size() != size) {
+        return false;
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+        if (record[i] != static_cast<std::byte>(value + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+class ShmRingTest : public ::testing::Test {};
+
+TEST_F(ShmRingTest, ReserveCommitPeekRelease) {
+    auto ring = ShmRing::CreateAnonymous(4096);
+
+    Write(ring, 1, 10);
+    Write(ring, 2, 20);
+
+    auto first = ring.Peek();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_TRUE(Matches(*first, 1, 10));
+    ring.Release();
+
+    auto second = ring.Peek();
+    ASSERT_TRUE(second.has_value());
+    EXPECT_TRUE(Matches(*second, 2, 20));
+    ring.Release();
+}
+
+TEST_F(ShmRingTest, CloseDrainsThenEnds) {
+    auto ring = ShmRing::CreateAnonymous(4096);
+
+    Write(ring, 7, 16);
+    ring.Close();
+
+    EXPECT_THROW(ring.Reserve(8), RingClosed);
+
+    auto record = ring.Peek();
+    ASSERT_TRUE(record.has_value());
+    EXPECT_TRUE(Matches(*record, 7, 16));
+    ring.Release();
+
+    EXPECT_FALSE(ring.Peek().has_value());
+}
+
+TEST_F(ShmRingTest, RejectsOversizedRecords) {
+    auto ring = ShmRing::CreateAnonymous(1024);
+
+    EXPECT_THROW(ring.Reserve(ring.MaxRecordSize() + 1), Exception);
+    EXPECT_NO_THROW(ring.Reserve(ring.MaxRecordSize()));
+}
+
+TEST_F(ShmRingTest, ConcurrentProducerAndConsumerWrapAround) {
+    auto ring                 = ShmRing::CreateAnonymous(1024);
+    constexpr int kNumRecords = 20000;
+
+    std::thread producer([&]() {
+        for (int i = 0; i < kNumRecords; ++i) {
+            Write(ring, static_cast<uint32_t>(i), static_cast<std::size_t>(1 + (i * 37) % 300));
+        }
+        ring.Close();
+    });
+
+    int received = 0;
+    bool ordered = true;
+    while (auto record = ring.Peek()) {
+        ordered = ordered && Matches(*record, static_cast<uint32_t>(received), static_cast<std::size_t>(1 + (received * 37) % 300));
+        ring.Release();
+        ++received;
+    }
+    producer.join();
+
+    EXPECT_EQ(received, kNumRecords);
+    EXPECT_TRUE(ordered);
+}
+
+TEST_F(ShmRingTest, NamedRingAcrossProcesses) {
+    const std::string name = "/eurora-ring-ut-" + std::to_string(::getpid());
+    auto ring              = ShmRing::Create(name, 4096);
+    constexpr int kNumRecords = 1000;
+
+    pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        auto peer = ShmRing::Open(name);
+        for (int i = 0; i < kNumRecords; ++i) {
+            Write(peer, static_cast<uint32_t>(i), 64);
+        }
+        peer.Close();
+        ::_exit(0);
+    }
+
+    int received = 0;
+    while (auto record = ring.Peek()) {
+        EXPECT_TRUE(Matches(*record, static_cast<uint32_t>(received), 64));
+        ring.Release();
+        ++received;
+    }
+
+    int status = 0;
+    ::waitpid(child, &status, 0);
+    EXPECT_EQ(received, kNumRecords);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
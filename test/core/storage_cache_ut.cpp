@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/storage_cache.hpp"
+
+using namespace eurora::core;
+
+namespace {
+
+StorageItemTags Tags(const std::string& name) { return StorageItemTags::Builder("subject").with_device("scanner").with_name(name).build(); }
+
+}  // namespace
+
+TEST(StorageCacheTest, HitsAfterPut) {
+    StorageCache cache(1 << 20);
+
+    EXPECT_EQ(cache.get<std::vector<float>>(Tags("coils")), nullptr);
+    cache.put(Tags("coils"), std::vector<float>(16, 1.0f), cache.epoch());
+
+    auto hit = cache.get<std::vector<float>>(Tags("coils"));
+    ASSERT_NE(hit, nullptr);
+    EXPECT_EQ(hit->size(), 16u);
+
+    // Same tags but another type is a separate entry.
+    EXPECT_EQ(cache.get<std::string>(Tags("coils")), nullptr);
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.entries, 1u);
+    EXPECT_DOUBLE_EQ(stats.hit_rate(), 1.0 / 3.0);
+}
+
+TEST(StorageCacheTest, EvictsLeastRecentlyUsedWhenFull) {
+    const std::size_t entry_size = CachedSize(std::vector<double>(100));
+    StorageCache cache(entry_size * 2);
+
+    cache.put(Tags("a"), std::vector<double>(100), cache.epoch());
+    cache.put(Tags("b"), std::vector<double>(100), cache.epoch());
+    ASSERT_NE(cache.get<std::vector<double>>(Tags("a")), nullptr);
+    cache.put(Tags("c"), std::vector<double>(100), cache.epoch());
+
+    EXPECT_NE(cache.get<std::vector<double>>(Tags("a")), nullptr);
+    EXPECT_EQ(cache.get<std::vector<double>>(Tags("b")), nullptr);
+    EXPECT_NE(cache.get<std::vector<double>>(Tags("c")), nullptr);
+    EXPECT_EQ(cache.stats().evictions, 1u);
+    EXPECT_LE(cache.stats().bytes, cache.capacity());
+
+    // Larger than the whole cache: not cached, nothing evicted for it.
+    cache.put(Tags("huge"), std::vector<double>(1000), cache.epoch());
+    EXPECT_EQ(cache.get<std::vector<double>>(Tags("huge")), nullptr);
+    EXPECT_EQ(cache.stats().entries, 2u);
+}
+
+TEST(StorageCacheTest, WritesInvalidateMatchingQueries) {
+    StorageCache cache(1 << 20);
+    auto broad = StorageItemTags::Builder("subject").with_name("noise").build();
+    auto other = StorageItemTags::Builder("subject").with_name("weights").build();
+
+    cache.put(broad, 1, cache.epoch());
+    cache.put(other, 2, cache.epoch());
+
+    // The stored item carries more tags than the query; the query would now return it.
+    cache.invalidate(StorageItemTags::Builder("subject").with_device("scanner").with_name("noise").build());
+
+    EXPECT_EQ(cache.get<int>(broad), nullptr);
+    EXPECT_NE(cache.get<int>(other), nullptr);
+    EXPECT_EQ(cache.stats().invalidations, 1u);
+}
+
+TEST(StorageCacheTest, DropsReadsThatRacedAWrite) {
+    StorageCache cache(1 << 20);
+
+    const auto epoch = cache.epoch();
+    cache.invalidate(Tags("coils"));
+    cache.put(Tags("coils"), 42, epoch);
+
+    EXPECT_EQ(cache.get<int>(Tags("coils")), nullptr);
+}
+
+TEST(StorageCacheTest, ExpiresEntries) {
+    StorageCache cache(1 << 20, std::chrono::seconds(0));
+
+    cache.put(Tags("coils"), 42, cache.epoch());
+    EXPECT_EQ(cache.get<int>(Tags("coils")), nullptr);
+    EXPECT_EQ(cache.stats().entries, 0u);
+}
+
+TEST(StorageCacheTest, ExportsHitsAndMissesAsMetrics) {
+    auto& registry     = eurora::utils::MetricsRegistry::Instance();
+    auto& hits         = registry.GetCounter("eurora_storage_cache_hits_total", "");
+    auto& misses       = registry.GetCounter("eurora_storage_cache_misses_total", "");
+    const auto hits0   = hits.Value();
+    const auto misses0 = misses.Value();
+
+    std::string text;
+    {
+        StorageCache cache(1 << 20);
+        EXPECT_EQ(cache.get<int>(Tags("coils")), nullptr);
+        cache.put(Tags("coils"), 42, cache.epoch());
+        EXPECT_NE(cache.get<int>(Tags("coils")), nullptr);
+        EXPECT_NE(cache.get<int>(Tags("coils")), nullptr);
+        text = registry.ExportPrometheus();
+    }
+
+    EXPECT_EQ(hits.Value() - hits0, 2u);
+    EXPECT_EQ(misses.Value() - misses0, 1u);
+    EXPECT_NE(text.find("eurora_storage_cache_entries 1\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE eurora_storage_cache_evictions_total counter\n"), std::string::npos);
+
+    // The gauges went away with the cache.
+    EXPECT_EQ(registry.ExportPrometheus().find("eurora_storage_cache_entries 1\n"), std::string::npos);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/storage_iterator.hpp"
+
+using namespace eurora::core;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Serves `total` items in pages, with the page offset as continuation.
+class PagedClient : public StorageClient {
+public:
+    explicit PagedClient(std::size_t total) : StorageClient("memory://"), total_(total) {}
+
+    StorageItemList list_items(const StorageItemTags&, size_t limit) override {
+        limit_ = limit;
+        return page(0);
+    }
+    StorageItemList get_next_page_of_items(const StorageItemList& previous) override {
+        std::this_thread::sleep_for(delay);
+        return page(std::stoul(previous.continuation));
+    }
+    std::shared_ptr<std::istream> get_latest_item(const StorageItemTags&) override { return nullptr; }
+    std::shared_ptr<std::istream> get_item_by_url(std::string_view url) override {
+        ++bodies_fetched;
+        return std::make_shared<std::istringstream>("body of " + std::string(url));
+    }
+    StorageItem store_item(const StorageItemTags&, std::istream&, std::optional<std::chrono::seconds>) override { return {}; }
+    std::optional<std::string> health_check() override { return std::nullopt; }
+
+    std::chrono::milliseconds delay{0};
+    std::atomic<int> bodies_fetched{0};
+
+private:
+    StorageItemList page(std::size_t offset) {
+        StorageItemList list;
+        for (std::size_t i = offset; i < std::min(total_, offset + limit_); ++i) {
+            StorageItem item;
+            item.location = "item/" + std::to_string(i);
+            item.data     = std::string(1024, 'x');
+            list.items.push_back(std::move(item));
+        }
+        list.complete = offset + limit_ >= total_;
+        if (!list.complete) {
+            list.continuation = std::to_string(offset + limit_);
+        }
+        return list;
+    }
+
+    std::size_t total_;
+    std::size_t limit_ = 0;
+};
+
+}  // namespace
+
+TEST(StorageItemCursorTest, VisitsEveryItemAcrossPages) {
+    auto client = std::make_shared<PagedClient>(25);
+    StorageItemCursor cursor(client, StorageItemTags::Builder("subject").build(), 10);
+
+    std::vector<std::string> locations;
+    for (const auto& item : cursor) {
+        EXPECT_TRUE(item.metadata().data.empty());
+        locations.push_back(item.location());
+    }
+
+    ASSERT_EQ(locations.size(), 25u);
+    EXPECT_EQ(locations.front(), "item/0");
+    EXPECT_EQ(locations.back(), "item/24");
+    EXPECT_EQ(cursor.pages_fetched(), 3u);
+    EXPECT_EQ(client->bodies_fetched, 0);
+}
+
+TEST(StorageItemCursorTest, LoadsBodiesOnDemand) {
+    auto client = std::make_shared<PagedClient>(3);
+    StorageItemCursor cursor(client, StorageItemTags::Builder("subject").build(), 10);
+
+    auto first = cursor.next();
+    ASSERT_TRUE(first);
+    auto body = first->open();
+    ASSERT_NE(body, nullptr);
+    std::string text((std::istreambuf_iterator<char>(*body)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(text, "body of item/0");
+    EXPECT_EQ(client->bodies_fetched, 1);
+}
+
+TEST(StorageItemCursorTest, PrefetchesWhileThePageIsConsumed) {
+    auto client   = std::make_shared<PagedClient>(40);
+    client->delay = 50ms;
+    StorageItemCursor cursor(client, StorageItemTags::Builder("subject").build(), 10);
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t count = 0;
+    while (auto item = cursor.next()) {
+        ++count;
+        std::this_thread::sleep_for(5ms);  // Ten items of work per page hide the page latency.
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(count, 40u);
+    // Serial fetching would take 3 * 50ms + 40 * 5ms = 350ms.
+    EXPECT_LT(elapsed, 300ms);
+}
+
+TEST(StorageItemCursorTest, HandlesEmptyListings) {
+    auto client = std::make_shared<PagedClient>(0);
+    StorageItemCursor cursor(client, StorageItemTags::Builder("subject").build());
+
+    EXPECT_EQ(cursor.begin(), cursor.end());
+}
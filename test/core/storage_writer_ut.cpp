@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/storage_writer.hpp"
+#include "core/task.hpp"
+
+using namespace eurora::core;
+using namespace std::chrono_literals;
+
+namespace {
+
+class RecordingClient : public StorageClient {
+public:
+    RecordingClient() : StorageClient("memory://") {}
+
+    StorageItemList list_items(const StorageItemTags&, size_t) override { return {}; }
+    StorageItemList get_next_page_of_items(const StorageItemList&) override { return {}; }
+    std::shared_ptr<std::istream> get_latest_item(const StorageItemTags&) override { return nullptr; }
+    std::shared_ptr<std::istream> get_item_by_url(std::string_view) override { return nullptr; }
+    std::optional<std::string> health_check() override { return std::nullopt; }
+
+    StorageItem store_item(const StorageItemTags& tags, std::istream& data, std::optional<std::chrono::seconds>) override {
+        std::this_thread::sleep_for(delay);
+        if (fail) {
+            throw std::runtime_error("backend unavailable");
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        writes.emplace_back(tags.name.value_or(""), std::string(std::istreambuf_iterator<char>(data), std::istreambuf_iterator<char>()));
+        return StorageItem{};
+    }
+
+    std::vector<std::pair<std::string, std::string>> Writes() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return writes;
+    }
+
+    std::chrono::milliseconds delay{0};
+    std::atomic<bool> fail{false};
+
+private:
+    std::mutex mutex;
+    std::vector<std::pair<std::string, std::string>> writes;
+};
+
+StorageItemTags Tags(const std::string& name) { return StorageItemTags::Builder("subject").with_name(name).build(); }
+
+StorageWriter::Serializer Payload(const std::string& text) {
+    return [text](std::ostream& stream) { stream << text; };
+}
+
+Task<std::thread::id> Settle(StorageWriter& writer, StorageItemTags query, ThreadPool& pool) {
+    co_await writer.async_settle(query, pool);
+    co_return std::this_thread::get_id();
+}
+
+Task<std::thread::id> Flush(StorageWriter& writer, ThreadPool& pool) {
+    co_await writer.async_flush(pool);
+    co_return std::this_thread::get_id();
+}
+
+}  // namespace
+
+TEST(StorageWriterTest, EnqueueDoesNotWaitForTheBackend) {
+    auto client   = std::make_shared<RecordingClient>();
+    client->delay = 200ms;
+    StorageWriter writer(client, {.max_pending = 8, .coalesce_window = 0ms});
+
+    auto start = std::chrono::steady_clock::now();
+    writer.enqueue(Tags("coils"), Payload("maps"), std::nullopt);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 100ms);
+
+    writer.flush();
+    ASSERT_EQ(client->Writes().size(), 1u);
+    EXPECT_EQ(client->Writes()[0].second, "maps");
+}
+
+TEST(StorageWriterTest, CoalescesOverwritesWithinTheWindow) {
+    auto client = std::make_shared<RecordingClient>();
+    StorageWriter writer(client, {.max_pending = 8, .coalesce_window = 10s});
+
+    writer.enqueue(Tags("noise"), Payload("first"), std::nullopt);
+    writer.enqueue(Tags("noise"), Payload("second"), std::nullopt);
+    writer.enqueue(Tags("weights"), Payload("other"), std::nullopt);
+    writer.flush();
+
+    auto writes = client->Writes();
+    ASSERT_EQ(writes.size(), 2u);
+    EXPECT_EQ(writes[0], std::make_pair(std::string("noise"), std::string("second")));
+    EXPECT_EQ(writes[1].first, "weights");
+    EXPECT_EQ(writer.stats().coalesced, 1u);
+}
+
+TEST(StorageWriterTest, BlocksWhenTheQueueIsFull) {
+    auto client   = std::make_shared<RecordingClient>();
+    client->delay = 20ms;
+    StorageWriter writer(client, {.max_pending = 2, .coalesce_window = 0ms});
+
+    for (int i = 0; i < 10; ++i) {
+        writer.enqueue(Tags("item" + std::to_string(i)), Payload(std::to_string(i)), std::nullopt);
+        EXPECT_LE(writer.stats().pending, 3u);
+    }
+    writer.flush();
+
+    EXPECT_EQ(client->Writes().size(), 10u);
+    EXPECT_GT(writer.stats().blocked, 0u);
+}
+
+TEST(StorageWriterTest, SettleWaitsOnlyForMatchingWrites) {
+    auto client = std::make_shared<RecordingClient>();
+    StorageWriter writer(client, {.max_pending = 8, .coalesce_window = 10s});
+
+    writer.enqueue(Tags("noise"), Payload("covariance"), std::nullopt);
+    writer.settle(Tags("weights"));
+    EXPECT_TRUE(client->Writes().empty());
+
+    writer.settle(StorageItemTags::Builder("subject").build());
+    EXPECT_EQ(client->Writes().size(), 1u);
+}
+
+TEST(StorageWriterTest, CountsFailuresAndDrainsOnDestruction) {
+    auto client = std::make_shared<RecordingClient>();
+    {
+        StorageWriter writer(client, {.max_pending = 8, .coalesce_window = 10s});
+        client->fail = true;
+        writer.enqueue(Tags("lost"), Payload("x"), std::nullopt);
+        writer.flush();
+        EXPECT_EQ(writer.stats().failed, 1u);
+
+        client->fail = false;
+        writer.enqueue(Tags("kept"), Payload("y"), std::nullopt);
+    }
+    ASSERT_EQ(client->Writes().size(), 1u);
+    EXPECT_EQ(client->Writes()[0].first, "kept");
+}
+
+TEST(StorageWriterTest, AsyncFlushResumesOnThePool) {
+    auto client   = std::make_shared<RecordingClient>();
+    client->delay = 50ms;
+    ThreadPool pool(1, "storage_writer_test");  // Outlives the writer, whose thread may still be pushing to it.
+    StorageWriter writer(client, {.max_pending = 8, .coalesce_window = 10s});
+    const auto worker = pool.Push([]() { return std::this_thread::get_id(); }).get();
+
+    writer.enqueue(Tags("noise"), Payload("covariance"), std::nullopt);
+
+    // Nothing matches, so the coroutine carries on without suspending.
+    EXPECT_EQ(Spawn(Settle(writer, Tags("weights"), pool)).get(), std::this_thread::get_id());
+
+    EXPECT_EQ(Spawn(Flush(writer, pool)).get(), worker);
+    EXPECT_EQ(client->Writes().size(), 1u);
+    EXPECT_EQ(writer.stats().pending, 0u);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "core/task_graph.hpp"
+
+using namespace eurora::utils;
+using namespace eurora::core;
+
+class TaskGraphTest : public ::testing::Test {};
+
+TEST_F(TaskGraphTest, NodesRunAfterTheirPredecessors) {
+    ThreadPool pool(4, "graph_test");
+
+    std::mutex mutex;
+    std::vector<std::string> order;
+    auto stage = [&mutex, &order](std::string name) {
+        return [&mutex, &order, name]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(name);
+        };
+    };
+
+    TaskGraph graph;
+    auto prewhiten   = graph.Add(stage("prewhiten"));
+    auto coil_maps   = graph.Add(stage("coil_maps"));
+    auto calibration = graph.Add(stage("calibration"), {prewhiten});
+    graph.Add(stage("combine"), {coil_maps, calibration});
+    EXPECT_EQ(graph.Size(), 4u);
+
+    auto position = [&order](const std::string& name) { return std::find(order.begin(), order.end(), name) - order.begin(); };
+    for (int repetition = 0; repetition < 3; ++repetition) {
+        order.clear();
+        graph.Run(pool).get();
+        ASSERT_EQ(order.size(), 4u);
+        EXPECT_LT(position("prewhiten"), position("calibration"));
+        EXPECT_LT(position("calibration"), position("combine"));
+        EXPECT_LT(position("coil_maps"), position("combine"));
+    }
+}
+
+TEST_F(TaskGraphTest, WideGraphsRunOnASingleWorkerWithoutBlocking) {
+    ThreadPool pool(1, "graph_test");
+
+    std::atomic<int> slices{0};
+    std::atomic<int> merged{-1};
+    TaskGraph graph;
+    auto setup = graph.Add([]() {});
+    std::vector<TaskGraph::NodeId> fan_out;
+    for (int i = 0; i < 100; ++i) {
+        fan_out.push_back(graph.Add([&slices]() { ++slices; }, {setup}));
+    }
+    graph.Add([&slices, &merged]() { merged = slices.load(); }, fan_out);
+
+    auto first  = graph.Run(pool);
+    auto second = graph.Run(pool);
+    first.get();
+    second.get();
+    EXPECT_EQ(slices.load(), 200);
+    EXPECT_GE(merged.load(), 100);
+}
+
+TEST_F(TaskGraphTest, FailureSkipsTheRemainingNodes) {
+    ThreadPool pool(2, "graph_test");
+
+    std::atomic<bool> ran_dependent{false};
+    TaskGraph graph;
+    auto failing = graph.Add([]() { throw std::runtime_error("coil maps failed"); });
+    graph.Add([&ran_dependent]() { ran_dependent = true; }, {failing});
+
+    auto result = graph.Run(pool);
+    EXPECT_THROW(result.get(), std::runtime_error);
+    EXPECT_FALSE(ran_dependent.load());
+
+    EXPECT_THROW(graph.Add([]() {}, {7}), std::invalid_argument);
+    EXPECT_NO_THROW(TaskGraph().Run(pool).get());
+}
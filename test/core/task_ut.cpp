@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/messaging/mpmc_channel.h"
+#include "core/thread_pool.hpp"
+
+using namespace eurora::utils;
+using namespace eurora::core;
+
+class TaskTest : public ::testing::Test {};
+
+namespace {
+
+Task<int> Add(int a, int b) { co_return a + b; }
+
+Task<int> Sum(int depth) {
+    int total = 0;
+    for (int i = 0; i < depth; ++i) {
+        total += co_await Add(i, 0);
+    }
+    co_return total;
+}
+
+Task<std::thread::id> HopOnto(ThreadPool& pool) {
+    co_await pool.Schedule();
+    co_return std::this_thread::get_id();
+}
+
+Task<void> Fail() {
+    co_await Add(1, 2);
+    throw std::runtime_error("stage failed");
+}
+
+Task<int> Consume(ThreadPool& pool, MPMCChannel<int>& channel, int count) {
+    co_await pool.Schedule();
+    int total = 0;
+    for (int i = 0; i < count; ++i) {
+        total += co_await channel.async_pop();
+        co_await pool.Schedule();
+    }
+    co_return total;
+}
+
+Task<int> Stage(ThreadPool& pool, int slice) {
+    co_await pool.Schedule({TaskPriority::kBatch});
+    auto scaled = co_await pool.Submit([](int value) { return value * 2; }, slice);
+    co_await pool.Schedule();
+    co_return scaled + 1;
+}
+
+}  // namespace
+
+TEST_F(TaskTest, AwaitsNestedTasks) {
+    EXPECT_EQ(Spawn(Add(2, 3)).get(), 5);
+    EXPECT_EQ(Spawn(Sum(1000)).get(), 499500);
+}
+
+TEST_F(TaskTest, ResumesOnThePoolAndPropagatesExceptions) {
+    ThreadPool pool(2, "task_test");
+
+    EXPECT_NE(Spawn(HopOnto(pool)).get(), std::this_thread::get_id());
+    EXPECT_EQ(Spawn(pool.Submit([](const std::string& text) { return text.size(); }, std::string("coil maps"))).get(), 9u);
+
+    std::atomic<bool> ran{false};
+    Spawn(pool.Submit([&ran]() { ran = true; })).get();
+    EXPECT_TRUE(ran.load());
+
+    EXPECT_THROW(Spawn(Fail()).get(), std::runtime_error);
+}
+
+TEST_F(TaskTest, ThousandsOfStagesShareAFewWorkers) {
+    ThreadPool pool(2, "task_test");
+
+    std::vector<std::future<int>> stages;
+    for (int slice = 0; slice < 5000; ++slice) {
+        stages.push_back(Spawn(Stage(pool, slice)));
+    }
+    long long total = 0;
+    for (auto& stage : stages) {
+        total += stage.get();
+    }
+    EXPECT_EQ(total, 2ll * (4999ll * 5000 / 2) + 5000);
+}
+
+TEST_F(TaskTest, AwaitingAChannelDoesNotParkAWorker) {
+    ThreadPool pool(1, "task_test");
+    MPMCChannel<int> channel;
+
+    // With a single worker, a consumer blocked in pop() would keep the producer from ever running.
+    auto consumer = Spawn(Consume(pool, channel, 100));
+    pool.Push([&channel]() {
+            for (int i = 0; i < 100; ++i) {
+                channel.push(i);
+            }
+        })
+        .get();
+    EXPECT_EQ(consumer.get(), 4950);
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <atomic>
+#include <future>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 #include "core/thread_pool.hpp"
@@ -93,3 +96,108 @@ TEST_F(ThreadPoolTest, TaskOverflow) {
 
     EXPECT_EQ(counter.load(), 100);
 }
+
+TEST_F(ThreadPoolTest, ExportsQueueDepthAndUtilization) {
+    std::string text;
+    {
+        ThreadPool pool(1, "metrics_test");
+
+        std::promise<void> release;
+        auto blocked = release.get_future().share();
+        std::promise<void> started;
+        pool.Push([&started, blocked]() {
+            started.set_value();
+            blocked.wait();
+        });
+        started.get_future().wait();
+        pool.Push([]() {});
+        pool.Push([]() {});
+
+        text = MetricsRegistry::Instance().ExportPrometheus();
+        release.set_value();
+        pool.Stop();
+    }
+
+    EXPECT_NE(text.find("eurora_queue_depth{queue=\"metrics_test\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("eurora_thread_pool_workers{pool=\"metrics_test\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("eurora_thread_pool_busy_workers{pool=\"metrics_test\"} 1\n"), std::string::npos);
+
+    EXPECT_EQ(MetricsRegistry::Instance().GetCounter("eurora_thread_pool_tasks_total", "", {{"pool", "metrics_test"}}).Value(), 3u);
+    EXPECT_EQ(MetricsRegistry::Instance().ExportPrometheus().find("queue=\"metrics_test\""), std::string::npos);
+}
+
+TEST_F(ThreadPoolTest, TasksChargeThePushersResourceAccount) {
+    ThreadPool pool(2);
+    ResourceAccount account;
+
+    {
+        ResourceScope scope(&account);
+        std::vector<std::future<void>> results;
+        for (int i = 0; i < 4; ++i) {
+            results.push_back(pool.Push([]() { ResourceAccount::CountRead(10); }));
+        }
+        for (auto& result : results) {
+            result.get();
+        }
+    }
+    pool.Push([]() { ResourceAccount::CountRead(1000); }).get();
+
+    EXPECT_EQ(account.Usage().bytes_read, 40u);
+}
+
+TEST_F(ThreadPoolTest, GroupsRunTasksOnTheirNodeAndCpus) {
+    auto groups = ThreadPool::NumaGroups(2);
+    ASSERT_FALSE(groups.empty());
+    const int node = groups.front().node;
+    const int cpu  = groups.front().cpus.front();
+    groups.push_back({1, {cpu}, -1});
+
+    ThreadPool pool(groups, "numa_test");
+
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(pool.PushToNode(node, []() { return sched_getcpu(); }).get() >= 0);
+    }
+    EXPECT_EQ(pool.Push([]() { return 1; }).get() + pool.Push([]() { return 2; }).get() + pool.PushToNode(99, []() { return 3; }).get(), 6);
+
+    std::vector<float> slice(1 << 16, 0.0f);
+    EXPECT_EQ(pool.PushNear(slice.data(), [&slice]() { return slice.size(); }).get(), slice.size());
+
+    // The extra group is pinned to one CPU; reaching it takes one round robin turn among the groups.
+    std::vector<std::future<int>> cpus;
+    for (size_t i = 0; i < 2 * groups.size(); ++i) {
+        cpus.push_back(pool.Push([]() { return sched_getcpu(); }));
+    }
+    bool pinned = false;
+    for (auto& result : cpus) {
+        pinned = pinned || result.get() == cpu;
+    }
+    EXPECT_TRUE(pinned);
+}
+
+TEST_F(ThreadPoolTest, InteractiveTasksOvertakeQueuedBatchWork) {
+    ThreadPool pool(1, "priority_test");
+
+    // Hold the only worker so everything below queues up behind it.
+    std::promise<void> release;
+    auto blocker = pool.Push([gate = release.get_future().share()]() { gate.wait(); });
+
+    std::mutex mutex;
+    std::vector<std::string> order;
+    auto record = [&mutex, &order](std::string name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(std::move(name));
+    };
+
+    std::vector<std::future<void>> results;
+    for (int i = 0; i < 3; ++i) {
+        results.push_back(pool.PushScheduled({TaskPriority::kBatch}, record, "batch"));
+    }
+    results.push_back(pool.Push(record, "normal"));
+    results.push_back(pool.PushScheduled({TaskPriority::kInteractive}, record, "interactive"));
+
+    release.set_value();
+    for (auto& result : results) {
+        result.get();
+    }
+    EXPECT_EQ(order, (std::vector<std::string>{"interactive", "normal", "batch", "batch", "batch"}));
+}
@@ -1,15 +1,35 @@
 #include <gtest/gtest.h>
 #include <chrono>
+#include <future>
+#include <iterator>
 #include <optional>
+#include <stop_token>
 #include <thread>
 #include <vector>
+#include "core/task.hpp"
 #include "core/thread_safe_queue.hpp"
 
 using namespace eurora::utils;
 using namespace eurora::core;
+using namespace std::chrono_literals;
 
 class ThreadSafeQueueTest : public ::testing::Test {};
 
+namespace {
+
+Task<std::vector<int>> DrainUntilClosed(ThreadSafeQueue<int>& queue) {
+    std::vector<int> messages;
+    try {
+        while (true) {
+            messages.push_back(co_await queue.AsyncPop());
+        }
+    } catch (const QueueClosed&) {
+    }
+    co_return messages;
+}
+
+}  // namespace
+
 TEST_F(ThreadSafeQueueTest, PushAndPop) {
     ThreadSafeQueue<int> queue;
 
@@ -144,3 +164,104 @@ TEST_F(ThreadSafeQueueTest, MultipleProducersAndConsumers) {
 
     EXPECT_EQ(consumed_count, kNumProducers * kNumElementsPerProducer);
 }
+
+TEST_F(ThreadSafeQueueTest, PushBulkAndPopBulk) {
+    ThreadSafeQueue<int> queue;
+
+    std::vector<int> lines(256);
+    for (int i = 0; i < 256; ++i) {
+        lines[static_cast<size_t>(i)] = i;
+    }
+    queue.PushBulk(lines);
+    queue.PushBulk(std::vector<int>{});
+    EXPECT_EQ(queue.Size(), 256u);
+
+    std::vector<int> out;
+    EXPECT_EQ(queue.PopBulk(std::back_inserter(out), 100), 100u);
+    EXPECT_EQ(queue.PopBulk(std::back_inserter(out), 1000), 156u);
+    EXPECT_EQ(out, lines);
+    EXPECT_EQ(queue.PopBulk(std::back_inserter(out), 0), 0u);
+}
+
+TEST_F(ThreadSafeQueueTest, PopBulkWaitsAndDrainsBeforeClose) {
+    ThreadSafeQueue<int> queue;
+
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        queue.PushBulk(std::vector<int>{1, 2, 3});
+        queue.Close();
+    });
+
+    std::vector<int> out;
+    size_t popped = 0;
+    while (popped < 3) {
+        popped += queue.PopBulk(std::back_inserter(out), 8);
+    }
+    EXPECT_EQ(out, (std::vector<int>{1, 2, 3}));
+
+    producer.join();
+    EXPECT_THROW(queue.PopBulk(std::back_inserter(out), 8), QueueClosed);
+    EXPECT_THROW(queue.PushBulk(std::vector<int>{4}), QueueClosed);
+}
+
+TEST_F(ThreadSafeQueueTest, PopForTimesOutWithoutClosing) {
+    ThreadSafeQueue<int> queue;
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.PopFor(std::chrono::milliseconds(20)).has_value());
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+    queue.Push(7);
+    EXPECT_EQ(queue.PopUntil(std::chrono::steady_clock::now() - std::chrono::seconds(1)), 7);
+
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.Push(8);
+    });
+    EXPECT_EQ(queue.PopFor(std::chrono::seconds(10)), 8);
+    producer.join();
+
+    std::vector<int> batch;
+    queue.PushBulk(std::vector<int>{1, 2});
+    EXPECT_EQ(queue.PopBulkUntil(std::back_inserter(batch), 8, std::chrono::steady_clock::now() + std::chrono::milliseconds(5)), 2u);
+    EXPECT_EQ(queue.PopBulkUntil(std::back_inserter(batch), 8, std::chrono::steady_clock::now() + std::chrono::milliseconds(5)), 0u);
+
+    queue.Close();
+    EXPECT_THROW(queue.PopFor(std::chrono::seconds(10)), QueueClosed);
+}
+
+TEST_F(ThreadSafeQueueTest, CancellationStopsOneConsumerOnly) {
+    ThreadSafeQueue<int> queue;
+    std::stop_source cancelled;
+
+    std::thread consumer([&queue, token = cancelled.get_token()]() { EXPECT_FALSE(queue.Pop(token).has_value()); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    cancelled.request_stop();
+    consumer.join();
+
+    // The queue stays open for everyone else.
+    queue.Push(1);
+    EXPECT_EQ(queue.Pop(std::stop_token{}), 1);
+    EXPECT_FALSE(queue.PopFor(std::chrono::seconds(10), cancelled.get_token()).has_value());
+}
+
+TEST_F(ThreadSafeQueueTest, AsyncPopResumesOnPushFromAnotherThread) {
+    ThreadSafeQueue<int> queue;
+    auto drained = Spawn(DrainUntilClosed(queue));
+    EXPECT_EQ(drained.wait_for(0s), std::future_status::timeout);
+
+    std::thread producer([&queue]() {
+        for (int i = 0; i < 1000; ++i) {
+            queue.Push(i);
+        }
+        queue.PushBulk(std::vector<int>{1000, 1001});
+        queue.Close();
+    });
+    producer.join();
+
+    auto messages = drained.get();
+    ASSERT_EQ(messages.size(), 1002u);
+    for (size_t i = 0; i < messages.size(); ++i) {
+        EXPECT_EQ(messages[i], static_cast<int>(i));
+    }
+}
@@ -0,0 +1,87 @@
+// Everything below logs as the "imaging" module, with debug and trace statements compiled out.
+#define EURORA_LOG_MODULE "imaging"
+#undef EURORA_LOG_ACTIVE_LEVEL
+#define EURORA_LOG_ACTIVE_LEVEL EURORA_LOG_LEVEL_INFO
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "eurora/utils/logger.h"
+
+using namespace eurora::utils;
+
+namespace {
+
+int evaluated = 0;
+
+int Evaluate() { return ++evaluated; }
+
+std::string CreateConfig() {
+    std::string config = "temp_log_module_config.json";
+    std::ofstream file(config);
+    file << R"({
+        "log_level": "warn",
+        "log_flush_level": "trace",
+        "enable_console_log": false,
+        "enable_file_log": true,
+        "log_file_path": "logs/test_log_module.log",
+        "module_levels": {"imaging": "info"}
+    })";
+    return config;
+}
+
+bool LogsContain(const std::string& text) {
+    for (const auto& entry : std::filesystem::directory_iterator("logs")) {
+        std::ifstream file(entry.path());
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (content.find(text) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+class LoggerModuleTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config_   = CreateConfig();
+        evaluated = 0;
+        Logger::Instance().InitFromConfig(config_);
+    }
+
+    void TearDown() override {
+        Logger::Instance().Shutdown();
+        std::remove(config_.c_str());
+    }
+
+    std::string config_;
+};
+
+}  // namespace
+
+TEST_F(LoggerModuleTest, CompiledOutStatementsDoNotEvaluateArguments) {
+    Logger::Instance().SetModuleLevel("imaging", LogLevel::Trace);
+
+    LOG_TRACE("trace {}", Evaluate());
+    LOG_DEBUG("debug {}", Evaluate());
+    STREAM_DEBUG() << Evaluate();
+    EXPECT_EQ(evaluated, 0);
+
+    LOG_INFO("info {}", Evaluate());
+    EXPECT_EQ(evaluated, 1);
+}
+
+TEST_F(LoggerModuleTest, ConfiguredModuleLevelLetsStatementsThrough) {
+    EXPECT_EQ(Logger::Instance().GetLevel(), LogLevel::Warn);
+    EXPECT_EQ(Logger::Instance().Module("imaging").level(), LogLevel::Info);
+
+    LOG_INFO("module marker {}", 17);
+    Logger::Instance().ResetModuleLevel("imaging");
+    LOG_INFO("module marker {}", Evaluate());
+
+    EXPECT_EQ(evaluated, 0);
+    EXPECT_TRUE(LogsContain("module marker 17"));
+}
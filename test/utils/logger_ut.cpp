@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
+#include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "eurora/utils/logger.h"
 
@@ -70,3 +75,115 @@ TEST_F(LoggerTest, SetAndGetLogLevel) {
 TEST_F(LoggerTest, FlushOnSpecificLevel) { EXPECT_NO_THROW(Logger::Instance().FlushOn(LogLevel::Warn)); }
 
 TEST_F(LoggerTest, ShutdownLogger) { EXPECT_NO_THROW(Logger::Instance().Shutdown()); }
+
+namespace {
+
+struct CountsStreaming {
+    int* count;
+};
+
+std::ostream& operator<<(std::ostream& os, const CountsStreaming& value) {
+    ++*value.count;
+    return os;
+}
+
+bool LogsContain(const std::string& text) {
+    for (const auto& entry : std::filesystem::directory_iterator("logs")) {
+        std::ifstream file(entry.path());
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (content.find(text) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+TEST(LoggerFileBasenameTest, StripsDirectoriesAtCompileTime) {
+    static_assert(std::string_view(FileBasename("src/core/thread_pool.hpp")) == "thread_pool.hpp");
+    static_assert(std::string_view(FileBasename("C:\\eurora\\main.cpp")) == "main.cpp");
+    static_assert(std::string_view(FileBasename("main.cpp")) == "main.cpp");
+}
+
+TEST_F(LoggerTest, DisabledStatementsAreNotBuilt) {
+    Logger::Instance().SetLevel(LogLevel::Warn);
+    int streamed = 0;
+    STREAM_DEBUG() << CountsStreaming{&streamed};
+    EXPECT_EQ(streamed, 0);
+    STREAM_ERROR() << CountsStreaming{&streamed};
+    EXPECT_EQ(streamed, 1);
+}
+
+TEST_F(LoggerTest, AsyncStatementsReachTheSinks) {
+    Logger::Instance().FlushOn(LogLevel::Trace);
+    Logger::Instance().EnableAsync();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < 1000; ++i) {
+                LOG_INFO("async marker {} {} {:.2f} {}", t, i, i * 0.5, std::string("from a worker"));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    LOG_INFO("async marker {}", "last");
+    Logger::Instance().Flush();
+
+    EXPECT_EQ(Logger::Instance().DroppedRecords(), 0u);
+    EXPECT_TRUE(LogsContain("async marker 3 999 499.50 from a worker"));
+    EXPECT_TRUE(LogsContain("async marker last"));
+}
+
+TEST(LogRingTest, WrapsRecordsAroundTheBuffer) {
+    LogRing ring(4096);
+    std::vector<int> seen;
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(ring.TryWrite(100 + i % 7, [i](std::byte* out) { std::memcpy(out, &i, sizeof(i)); }));
+        ring.Drain([&seen](const std::byte* data, std::size_t size) {
+            EXPECT_GE(size, 100u);
+            int value;
+            std::memcpy(&value, data, sizeof(value));
+            seen.push_back(value);
+        });
+    }
+    ASSERT_EQ(seen.size(), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(seen[i], i);
+    }
+}
+
+TEST(LogRingTest, RejectsWritesWhenFull) {
+    LogRing ring(4096);
+    int written = 0;
+    while (ring.TryWrite(120, [](std::byte*) {})) {
+        ++written;
+    }
+    EXPECT_EQ(written, 4096 / 128);
+    EXPECT_EQ(ring.Drain([](const std::byte*, std::size_t) {}), static_cast<std::size_t>(written));
+    EXPECT_TRUE(ring.Empty());
+    EXPECT_TRUE(ring.TryWrite(120, [](std::byte*) {}));
+}
+
+TEST_F(LoggerTest, ModuleLevelsOverrideTheGlobalLevel) {
+    auto& logger = Logger::Instance();
+    logger.SetLevel(LogLevel::Info);
+    const auto& storage = logger.Module("storage");
+    const auto& math    = logger.Module("math");
+
+    logger.SetModuleLevel("storage", LogLevel::Trace);
+    EXPECT_TRUE(storage.ShouldLog(LogLevel::Trace));
+    EXPECT_FALSE(math.ShouldLog(LogLevel::Debug));
+    EXPECT_FALSE(logger.ShouldLog(LogLevel::Debug));
+
+    logger.SetLevel(LogLevel::Warn);
+    EXPECT_EQ(storage.level(), LogLevel::Trace);
+    EXPECT_EQ(math.level(), LogLevel::Warn);
+
+    logger.ResetModuleLevel("storage");
+    EXPECT_EQ(storage.level(), LogLevel::Warn);
+    EXPECT_EQ(&logger.Module("storage"), &storage);
+}
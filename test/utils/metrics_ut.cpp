@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "eurora/utils/exception.hpp"
+#include "eurora/utils/metrics.h"
+
+using namespace eurora::utils;
+
+TEST(MetricsTest, CountersSumEveryThreadsIncrements) {
+    auto& counter = MetricsRegistry::Instance().GetCounter("test_counter_total", "Counter under test.");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&counter]() {
+            for (int i = 0; i < 10000; ++i) {
+                counter.Increment();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(counter.Value(), 80000u);
+    EXPECT_EQ(&MetricsRegistry::Instance().GetCounter("test_counter_total", "Counter under test."), &counter);
+}
+
+TEST(MetricsTest, HistogramQuantilesStayWithinTheBucketPrecision) {
+    for (std::uint64_t value : {0ull, 1ull, 63ull, 64ull, 65ull, 1000ull, 123456789ull, ~0ull}) {
+        const auto index = Histogram::BucketIndex(value);
+        ASSERT_LT(index, Histogram::kBuckets);
+        EXPECT_GE(Histogram::BucketUpperBound(index), value);
+        EXPECT_LE(Histogram::BucketUpperBound(index) - value, value / 32);
+        if (index > 0) {
+            EXPECT_LT(Histogram::BucketUpperBound(index - 1), value);
+        }
+    }
+
+    Histogram histogram;
+    for (std::uint64_t value = 1; value <= 1000; ++value) {
+        histogram.Record(value * 1000);
+    }
+    const auto snapshot = histogram.TakeSnapshot();
+    EXPECT_EQ(snapshot.count, 1000u);
+    EXPECT_EQ(snapshot.sum, 500500u * 1000);
+    EXPECT_EQ(snapshot.max, 1000000u);
+    EXPECT_NEAR(static_cast<double>(snapshot.ValueAtQuantile(0.5)), 500000.0, 500000.0 / 32);
+    EXPECT_NEAR(static_cast<double>(snapshot.ValueAtQuantile(0.99)), 990000.0, 990000.0 / 32);
+    EXPECT_EQ(snapshot.ValueAtQuantile(1.0), 1000000u);
+}
+
+TEST(MetricsTest, ExportsThePrometheusTextFormat) {
+    auto& registry = MetricsRegistry::Instance();
+    registry.GetCounter("test_bytes_total", "Bytes \\ moved.", {{"direction", "in"}}).Increment(42);
+    registry.GetGauge("test_workers", "Busy workers.").Set(3);
+    registry.GetHistogram("test_latency_seconds", "Latency.", {{"op", "store"}}, 1e-9).Record(2000);
+
+    std::queue<int> queue;
+    queue.push(1);
+    queue.push(2);
+    std::string text;
+    {
+        auto depth = WatchQueueDepth("test", queue);
+        text       = registry.ExportPrometheus();
+    }
+
+    EXPECT_NE(text.find("# HELP test_bytes_total Bytes \\\\ moved.\n# TYPE test_bytes_total counter\n"), std::string::npos);
+    EXPECT_NE(text.find("test_bytes_total{direction=\"in\"} 42\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE test_workers gauge\ntest_workers 3\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE test_latency_seconds summary\n"), std::string::npos);
+    EXPECT_NE(text.find("test_latency_seconds{op=\"store\",quantile=\"0.5\"} 2"), std::string::npos);
+    EXPECT_NE(text.find("test_latency_seconds_count{op=\"store\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("eurora_queue_depth{queue=\"test\"} 2\n"), std::string::npos);
+
+    // The callback went away with its handle.
+    EXPECT_EQ(registry.ExportPrometheus().find("eurora_queue_depth{queue=\"test\"}"), std::string::npos);
+}
+
+TEST(MetricsTest, RejectsInvalidAndConflictingNames) {
+    auto& registry = MetricsRegistry::Instance();
+    EXPECT_THROW(registry.GetCounter("0starts_with_digit", ""), Exception);
+    EXPECT_THROW(registry.GetGauge("test_labelled", "", {{"bad-label", "x"}}), Exception);
+
+    registry.GetCounter("test_conflict", "");
+    EXPECT_THROW(registry.GetGauge("test_conflict", ""), Exception);
+}
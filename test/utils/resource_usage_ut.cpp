@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+#include "eurora/utils/resource_usage.h"
+
+using namespace eurora::utils;
+
+TEST(ResourceUsageTest, ChargesOnlyInsideAScope) {
+    ResourceAccount account;
+    ResourceAccount::CountRead(100);
+
+    {
+        ResourceScope scope(&account);
+        EXPECT_EQ(ResourceAccount::Current(), &account);
+        ResourceAccount::CountRead(10);
+        ResourceAccount::CountWritten(20);
+        {
+            StageTimer timer("decode");
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        // Pending charges only show after a flush.
+        EXPECT_EQ(account.Usage().bytes_read, 0u);
+        ResourceScope::Flush();
+        EXPECT_EQ(account.Usage().bytes_read, 10u);
+
+        ResourceAccount::CountRead(5);
+    }
+    EXPECT_EQ(ResourceAccount::Current(), nullptr);
+
+    const auto usage = account.Usage();
+    EXPECT_EQ(usage.bytes_read, 15u);
+    EXPECT_EQ(usage.bytes_written, 20u);
+    ASSERT_EQ(usage.stage_seconds.count("decode"), 1u);
+    EXPECT_GE(usage.stage_seconds.at("decode"), 0.005);
+}
+
+TEST(ResourceUsageTest, NestedScopesChargeTheInnermostAccount) {
+    ResourceAccount outer;
+    ResourceAccount inner;
+    {
+        ResourceScope outer_scope(&outer);
+        ResourceAccount::CountWritten(1);
+        {
+            ResourceScope inner_scope(&inner);
+            ResourceAccount::CountWritten(2);
+
+            // Burn some CPU so the inner account's share is measurable.
+            volatile double sink = 0;
+            for (int i = 0; i < 2'000'000; ++i) {
+                sink = sink + i * 0.5;
+            }
+        }
+        ResourceAccount::CountWritten(4);
+    }
+
+    EXPECT_EQ(outer.Usage().bytes_written, 5u);
+    EXPECT_EQ(inner.Usage().bytes_written, 2u);
+    EXPECT_GT(inner.Usage().cpu_seconds, 0.0);
+}
+
+TEST(ResourceUsageTest, SumsWorkFromSeveralThreadsAndKeepsThePeak) {
+    ResourceAccount account;
+    std::thread first([&account]() {
+        ResourceScope scope(&account);
+        ResourceAccount::CountRead(3);
+        account.UpdatePeakMemory(1000);
+    });
+    std::thread second([&account]() {
+        ResourceScope scope(&account);
+        ResourceAccount::CountRead(4);
+        account.UpdatePeakMemory(500);
+    });
+    first.join();
+    second.join();
+
+    EXPECT_EQ(account.Usage().bytes_read, 7u);
+    EXPECT_EQ(account.Usage().peak_memory_bytes, 1000u);
+}
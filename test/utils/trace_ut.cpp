@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "eurora/utils/trace.h"
+
+using namespace eurora::utils;
+
+namespace {
+
+std::size_t Count(const std::string& text, const std::string& needle) {
+    std::size_t count = 0;
+    for (auto at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+}  // namespace
+
+TEST(TracerTest, RecordsNothingWhenDisabled) {
+    auto& tracer = Tracer::Instance();
+    tracer.Start();
+    tracer.Stop();
+    {
+        EURORA_TRACE_SCOPE("test", "ignored");
+    }
+    EXPECT_EQ(tracer.EventCount(), 0u);
+}
+
+TEST(TracerTest, ExportsSpansFromEveryThread) {
+    auto& tracer = Tracer::Instance();
+    tracer.Start();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t]() {
+            Tracer::Instance().SetThreadName("worker " + std::to_string(t));
+            for (int i = 0; i < 5000; ++i) {
+                TraceSpan span("test", "work");
+                span.SetArg("index", i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    {
+        EURORA_TRACE_FUNCTION("test");
+    }
+    tracer.Stop();
+
+    EXPECT_EQ(tracer.EventCount(), 20001u);
+    EXPECT_EQ(tracer.DroppedEvents(), 0u);
+
+    std::ostringstream json;
+    tracer.WriteChromeTrace(json);
+    auto text = json.str();
+    EXPECT_EQ(text.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    EXPECT_EQ(Count(text, "\"name\":\"work\""), 20000u);
+    EXPECT_EQ(Count(text, "\"ph\":\"M\""), 4u);
+    EXPECT_NE(text.find("\"args\":{\"index\":4999}"), std::string::npos);
+    EXPECT_NE(text.find("\"name\":\"TestBody\""), std::string::npos);
+}
+
+TEST(TracerTest, CapsEventsPerThreadAndResetsOnStart) {
+    auto& tracer = Tracer::Instance();
+    tracer.Start(100);
+    for (int i = 0; i < 150; ++i) {
+        EURORA_TRACE_SCOPE("test", "capped");
+    }
+    EXPECT_EQ(tracer.EventCount(), 100u);
+    EXPECT_EQ(tracer.DroppedEvents(), 50u);
+
+    tracer.Start();
+    EXPECT_EQ(tracer.EventCount(), 0u);
+    {
+        EURORA_TRACE_SCOPE("test", "fresh");
+    }
+    EXPECT_EQ(tracer.EventCount(), 1u);
+    tracer.Stop();
+}
+
+TEST(TracerTest, ExportsWhileThreadsRecord) {
+    auto& tracer = Tracer::Instance();
+    tracer.Start(50000);
+
+    std::atomic<bool> stop{false};
+    std::thread recorder([&stop]() {
+        while (!stop.load()) {
+            EURORA_TRACE_SCOPE("test", "busy");
+        }
+    });
+
+    std::size_t previous = 0;
+    for (int i = 0; i < 5; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        std::ostringstream json;
+        tracer.WriteChromeTrace(json);
+        auto count = Count(json.str(), "\"name\":\"busy\"");
+        EXPECT_GE(count, previous);
+        previous = count;
+    }
+    stop = true;
+    recorder.join();
+    tracer.Stop();
+    EXPECT_GT(previous, 0u);
+}